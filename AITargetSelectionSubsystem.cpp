@@ -0,0 +1,183 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AITargetSelectionSubsystem.h"
+#include "AITargetSelectorComponent.h"
+#include "TargetScoring.h"
+#include "GameFramework/Pawn.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+
+void UAITargetSelectionSubsystem::RegisterSelector(UAITargetSelectorComponent* Selector)
+{
+	if (Selector)
+	{
+		Selectors.AddUnique(Selector);
+	}
+}
+
+void UAITargetSelectionSubsystem::UnregisterSelector(UAITargetSelectorComponent* Selector)
+{
+	// 批量选择的回调中注销时只清空槽位：交换删除会把末尾的组件移到当前位置而被跳过，空槽位在下次选择开始时清理
+	if (bIsRunningSelection)
+	{
+		const int32 Index = Selectors.Find(Selector);
+		if (Index != INDEX_NONE)
+		{
+			Selectors[Index].Reset();
+		}
+		return;
+	}
+
+	Selectors.RemoveSwap(Selector);
+}
+
+bool UAITargetSelectionSubsystem::IsSelectableTarget(const APawn* Pawn)
+{
+	if (!IsValid(Pawn))
+		return false;
+
+	return Pawn->IsPlayerControlled() || Pawn->ActorHasTag(FName("Player")) || Pawn->ActorHasTag(FName("Friendly"));
+}
+
+void UAITargetSelectionSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (Selectors.Num() == 0)
+		return;
+
+	TimeUntilNextSelection -= DeltaTime;
+	if (TimeUntilNextSelection > 0.0f)
+		return;
+
+	TimeUntilNextSelection = SELECTION_INTERVAL;
+	RunSelection();
+}
+
+TStatId UAITargetSelectionSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAITargetSelectionSubsystem, STATGROUP_Tickables);
+}
+
+bool UAITargetSelectionSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UAITargetSelectionSubsystem::RunSelection()
+{
+	// 清理失效的组件，并以最大锁定范围作为网格单元，保证3x3邻域覆盖所有AI的范围
+	float MaxRange = 0.0f;
+	for (int32 Index = Selectors.Num() - 1; Index >= 0; --Index)
+	{
+		UAITargetSelectorComponent* Selector = Selectors[Index].Get();
+		if (!Selector)
+		{
+			Selectors.RemoveAtSwap(Index);
+			continue;
+		}
+		MaxRange = FMath::Max(MaxRange, Selector->GetCompiledSettings().LockOn.LockOnRange);
+	}
+
+	LastNumPairs = 0;
+	if (Selectors.Num() == 0 || MaxRange <= 0.0f)
+		return;
+
+	CellSize = MaxRange;
+
+	// 目标只收集一次
+	Grid.Reset();
+	TargetActors.Reset();
+	TargetLocations.Reset();
+	for (TActorIterator<APawn> It(GetWorld()); It; ++It)
+	{
+		APawn* Pawn = *It;
+		if (!IsSelectableTarget(Pawn))
+			continue;
+
+		const int32 TargetIndex = TargetActors.Add(Pawn);
+		TargetLocations.Add(Pawn->GetActorLocation());
+		Grid.FindOrAdd(GetCell(TargetLocations[TargetIndex])).Add(TargetIndex);
+	}
+
+	UWorld* World = GetWorld();
+
+	// 事件回调中可能注册或注销选择组件：按索引遍历，注销只清空槽位（见UnregisterSelector）
+	TGuardValue<bool> RunningSelectionGuard(bIsRunningSelection, true);
+	for (int32 SelectorIndex = 0; SelectorIndex < Selectors.Num(); ++SelectorIndex)
+	{
+		UAITargetSelectorComponent* Selector = Selectors[SelectorIndex].Get();
+		AActor* SelectorOwner = Selector ? Selector->GetOwner() : nullptr;
+		if (!SelectorOwner)
+			continue;
+
+		const FCompiledLockOnSettings& Settings = Selector->GetCompiledSettings();
+		const FVector AgentLocation = SelectorOwner->GetActorLocation();
+		const FVector AgentForward = SelectorOwner->GetActorForwardVector();
+
+		// 范围与锥角判定后评分
+		ScoredScratch.Reset();
+		const FIntPoint Center = GetCell(AgentLocation);
+		for (int32 OffsetY = -1; OffsetY <= 1; ++OffsetY)
+		{
+			for (int32 OffsetX = -1; OffsetX <= 1; ++OffsetX)
+			{
+				const TArray<int32>* Cell = Grid.Find(Center + FIntPoint(OffsetX, OffsetY));
+				if (!Cell)
+					continue;
+
+				for (int32 TargetIndex : *Cell)
+				{
+					if (TargetActors[TargetIndex] == SelectorOwner)
+						continue;
+
+					++LastNumPairs;
+
+					const FVector& TargetLocation = TargetLocations[TargetIndex];
+					if (FVector::DistSquared(AgentLocation, TargetLocation) > Settings.LockOnRangeSquared)
+						continue;
+
+					if (FVector::DotProduct(AgentForward, (TargetLocation - AgentLocation).GetSafeNormal()) < Settings.LockOnHalfAngleCos)
+						continue;
+
+					ScoredScratch.Add({ TargetIndex, FTargetScoringResult::ScoreTarget(Settings, AgentLocation, AgentForward, TargetLocation) });
+				}
+			}
+		}
+
+		ScoredScratch.Sort([](const FScoredPair& A, const FScoredPair& B)
+		{
+			return A.Score > B.Score;
+		});
+
+		// 按得分从高到低，第一个视线未被遮挡的目标胜出
+		AActor* Selected = nullptr;
+		const FVector HeightOffset(0.0f, 0.0f, Settings.LockOn.RaycastHeightOffset);
+		const int32 NumToTry = FMath::Min(ScoredScratch.Num(), Selector->bRequireLineOfSight ? MAX_TRACES_PER_SELECTOR : 1);
+		for (int32 Index = 0; Index < NumToTry; ++Index)
+		{
+			const int32 TargetIndex = ScoredScratch[Index].TargetIndex;
+			if (Selector->bRequireLineOfSight)
+			{
+				FCollisionQueryParams QueryParams;
+				QueryParams.AddIgnoredActor(SelectorOwner);
+
+				FHitResult HitResult;
+				const bool bHit = World->LineTraceSingleByChannel(HitResult, AgentLocation + HeightOffset,
+					TargetLocations[TargetIndex] + HeightOffset, ECC_Visibility, QueryParams);
+				if (bHit && HitResult.GetActor() != TargetActors[TargetIndex])
+					continue;
+			}
+
+			Selected = TargetActors[TargetIndex];
+			break;
+		}
+
+		Selector->SetSelectedTarget(Selected);
+	}
+}
+
+FIntPoint UAITargetSelectionSubsystem::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
@@ -0,0 +1,78 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AITargetSelectionSubsystem.generated.h"
+
+class APawn;
+class UAITargetSelectorComponent;
+
+/**
+ * AI批量目标选择子系统
+ * 每个间隔只遍历一次场景中的玩家与友方Pawn，按位置放入平面网格（单元边长取最大锁定范围）；
+ * 每个AI只在相邻单元内做范围、锥角判定与评分（FTargetScoringResult::ScoreTarget，与玩家锁定相同），
+ * 按得分从高到低最多做几次视线检测，把结果写回各自的选择组件。
+ * 取代每个AI各自的重叠球体与排序，开销随附近的(AI, 目标)对数增长。
+ */
+UCLASS()
+class SOUL_API UAITargetSelectionSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** 选择间隔（秒） */
+	static constexpr float SELECTION_INTERVAL = 0.25f;
+
+	/** 每个AI每次最多做的视线检测数（高分目标被遮挡时依次尝试） */
+	static constexpr int32 MAX_TRACES_PER_SELECTOR = 3;
+
+	/** 注册/注销选择组件（BeginPlay/EndPlay调用） */
+	void RegisterSelector(UAITargetSelectorComponent* Selector);
+	void UnregisterSelector(UAITargetSelectorComponent* Selector);
+
+	/** AI可以选择的目标：玩家控制或带Player/Friendly标签的Pawn */
+	static bool IsSelectableTarget(const APawn* Pawn);
+
+	/** 上一次选择评估的(AI, 目标)对数 */
+	int32 GetLastNumPairs() const { return LastNumPairs; }
+
+	// UTickableWorldSubsystem
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** 一次批量选择：重建目标网格并为每个AI选出得分最高的目标 */
+	void RunSelection();
+
+	FIntPoint GetCell(const FVector& Location) const;
+
+	TArray<TWeakObjectPtr<UAITargetSelectorComponent>> Selectors;
+
+	/** 正在遍历Selectors写回结果（此时注销不能移动数组元素） */
+	bool bIsRunningSelection = false;
+
+	/** 本次选择的目标（结构数组） */
+	TArray<AActor*> TargetActors;
+	TArray<FVector> TargetLocations;
+
+	/** 网格单元 -> 目标索引 */
+	TMap<FIntPoint, TArray<int32>> Grid;
+
+	struct FScoredPair
+	{
+		int32 TargetIndex;
+		float Score;
+	};
+
+	/** 单个AI通过范围与锥角判定的目标（复用） */
+	TArray<FScoredPair> ScoredScratch;
+
+	float CellSize = 2000.0f;
+	float TimeUntilNextSelection = 0.0f;
+	int32 LastNumPairs = 0;
+};
@@ -0,0 +1,64 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AITargetSelectorComponent.h"
+#include "AITargetSelectionSubsystem.h"
+#include "Engine/World.h"
+
+UAITargetSelectorComponent::UAITargetSelectorComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UAITargetSelectorComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	RefreshSettings();
+
+	if (UAITargetSelectionSubsystem* Selection = GetWorld()->GetSubsystem<UAITargetSelectionSubsystem>())
+	{
+		Selection->RegisterSelector(this);
+	}
+}
+
+void UAITargetSelectorComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UWorld* World = GetWorld())
+	{
+		if (UAITargetSelectionSubsystem* Selection = World->GetSubsystem<UAITargetSelectionSubsystem>())
+		{
+			Selection->UnregisterSelector(this);
+		}
+	}
+
+	SelectedTarget.Reset();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UAITargetSelectorComponent::RefreshSettings()
+{
+	CompiledSettings = FCompiledLockOnSettings::Build(LockOnSettings, FCameraSettings(), FAdvancedCameraSettings());
+}
+
+const FCompiledLockOnSettings& UAITargetSelectorComponent::GetCompiledSettings() const
+{
+	if (!CompiledSettings.IsValid())
+	{
+		CompiledSettings = FCompiledLockOnSettings::Build(LockOnSettings, FCameraSettings(), FAdvancedCameraSettings());
+	}
+	return *CompiledSettings;
+}
+
+void UAITargetSelectorComponent::SetSelectedTarget(AActor* NewTarget)
+{
+	if (SelectedTarget.Get() == NewTarget)
+		return;
+
+	SelectedTarget = NewTarget;
+
+	if (OnTargetSelected.IsBound())
+	{
+		OnTargetSelected.Broadcast(NewTarget);
+	}
+}
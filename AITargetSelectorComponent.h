@@ -0,0 +1,59 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "LockOnConfig.h"
+#include "AITargetSelectorComponent.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnAITargetSelected, AActor*, NewTarget);
+
+/**
+ * AI目标选择组件
+ * 只保存配置与选择结果，不Tick、不持有重叠球体；
+ * 选择由UAITargetSelectionSubsystem对所有AI批量完成，评分规则与玩家的目标检测组件相同。
+ */
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class SOUL_API UAITargetSelectorComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UAITargetSelectorComponent();
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+public:
+	/** 范围、锥角与视线高度（与玩家锁定使用同一套设置） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Target Selection")
+	FLockOnSettings LockOnSettings;
+
+	/** 选中的目标必须通过视线检测 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Target Selection")
+	bool bRequireLineOfSight = true;
+
+	/** 选中的目标变化时触发 */
+	UPROPERTY(BlueprintAssignable, Category = "AI Target Selection")
+	FOnAITargetSelected OnTargetSelected;
+
+	/** 最近一次批量选择的结果 */
+	UFUNCTION(BlueprintPure, Category = "AI Target Selection")
+	AActor* GetSelectedTarget() const { return SelectedTarget.Get(); }
+
+	/** 修改LockOnSettings后调用，重新编译设置 */
+	UFUNCTION(BlueprintCallable, Category = "AI Target Selection")
+	void RefreshSettings();
+
+	const FCompiledLockOnSettings& GetCompiledSettings() const;
+
+	/** 写回选择结果（由子系统调用） */
+	void SetSelectedTarget(AActor* NewTarget);
+
+private:
+	mutable TSharedPtr<const FCompiledLockOnSettings> CompiledSettings;
+
+	TWeakObjectPtr<AActor> SelectedTarget;
+};
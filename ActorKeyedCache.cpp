@@ -0,0 +1,101 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ActorKeyedCache.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/OutputDevice.h"
+#include "UObject/UObjectGlobals.h"
+#include "Misc/ScopeLock.h"
+
+LLM_DEFINE_TAG(SoulActorCache);
+
+namespace ActorKeyedCacheRegistry
+{
+	/** 所有存活的缓存（函数内静态变量，保证在组件默认对象构造前可用） */
+	static TArray<FActorKeyedCacheBase*>& GetCaches()
+	{
+		static TArray<FActorKeyedCacheBase*> Caches;
+		return Caches;
+	}
+
+	/** 组件可能在异步加载线程上构造与析构，登记表本身需要加锁 */
+	static FCriticalSection& GetLock()
+	{
+		static FCriticalSection Lock;
+		return Lock;
+	}
+
+	/** 垃圾回收后清除所有缓存中已销毁Actor的条目 */
+	static void PurgeAllCaches()
+	{
+		FScopeLock ScopeLock(&GetLock());
+		for (FActorKeyedCacheBase* Cache : GetCaches())
+		{
+			Cache->PurgeStale();
+		}
+	}
+}
+
+FActorKeyedCacheBase::FActorKeyedCacheBase(const TCHAR* InName, int32 InCapacity)
+	: Name(InName)
+	, Capacity(InCapacity)
+{
+	FScopeLock ScopeLock(&ActorKeyedCacheRegistry::GetLock());
+
+	static bool bRegisteredGCHook = false;
+	if (!bRegisteredGCHook)
+	{
+		FCoreUObjectDelegates::GetPostGarbageCollect().AddStatic(&ActorKeyedCacheRegistry::PurgeAllCaches);
+		bRegisteredGCHook = true;
+	}
+
+	ActorKeyedCacheRegistry::GetCaches().Add(this);
+}
+
+FActorKeyedCacheBase::~FActorKeyedCacheBase()
+{
+	FScopeLock ScopeLock(&ActorKeyedCacheRegistry::GetLock());
+	ActorKeyedCacheRegistry::GetCaches().RemoveSingleSwap(this);
+}
+
+void FActorKeyedCacheBase::DumpAllCaches(FOutputDevice& Ar)
+{
+	// 同名缓存（每个组件实例各一份）合并输出
+	struct FCacheSummary
+	{
+		int32 Instances = 0;
+		int32 Entries = 0;
+		int32 Capacity = 0;
+		int32 Evictions = 0;
+		SIZE_T Bytes = 0;
+	};
+
+	FScopeLock ScopeLock(&ActorKeyedCacheRegistry::GetLock());
+
+	TMap<FString, FCacheSummary> Summaries;
+	SIZE_T TotalBytes = 0;
+	for (const FActorKeyedCacheBase* Cache : ActorKeyedCacheRegistry::GetCaches())
+	{
+		FCacheSummary& Summary = Summaries.FindOrAdd(Cache->GetName());
+		++Summary.Instances;
+		Summary.Entries += Cache->Num();
+		Summary.Capacity += Cache->GetCapacity();
+		Summary.Evictions += Cache->GetNumEvictions();
+		Summary.Bytes += Cache->GetAllocatedSize();
+		TotalBytes += Cache->GetAllocatedSize();
+	}
+
+	Ar.Logf(TEXT("Actor-keyed caches: %d instances, %.1f KB"), ActorKeyedCacheRegistry::GetCaches().Num(), TotalBytes / 1024.0f);
+	for (const TPair<FString, FCacheSummary>& Pair : Summaries)
+	{
+		Ar.Logf(TEXT("  %-32s Instances=%3d Entries=%5d/%-5d Evictions=%6d %8.1f KB"),
+			*Pair.Key, Pair.Value.Instances, Pair.Value.Entries, Pair.Value.Capacity, Pair.Value.Evictions, Pair.Value.Bytes / 1024.0f);
+	}
+}
+
+// ==================== 控制台命令 ====================
+
+static FAutoConsoleCommandWithOutputDevice CmdSoulCacheReport(
+	TEXT("Soul.Cache.Report"),
+	TEXT("Print entry counts, evictions and memory of every actor-keyed cache (add to [MemReportCommands] to include it in memreport)"),
+	FConsoleCommandWithOutputDeviceDelegate::CreateStatic(&FActorKeyedCacheBase::DumpAllCaches)
+);
@@ -0,0 +1,298 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "HAL/LowLevelMemTracker.h"
+
+class AActor;
+class FOutputDevice;
+
+LLM_DECLARE_TAG_API(SoulActorCache, SOUL_API);
+
+/**
+ * 以Actor为键的有界缓存的非模板部分
+ * 每个实例登记到全局列表：垃圾回收后统一清除已销毁Actor的条目，
+ * 并由 Soul.Cache.Report 汇总条目数与内存占用（可加入memreport的命令列表）。
+ * 条目的读写仅限游戏线程。
+ */
+class SOUL_API FActorKeyedCacheBase
+{
+public:
+	explicit FActorKeyedCacheBase(const TCHAR* InName, int32 InCapacity);
+	virtual ~FActorKeyedCacheBase();
+
+	FActorKeyedCacheBase(const FActorKeyedCacheBase&) = delete;
+	FActorKeyedCacheBase& operator=(const FActorKeyedCacheBase&) = delete;
+
+	/** 移除Actor已销毁的条目，返回移除的数量 */
+	virtual int32 PurgeStale() = 0;
+
+	/** 当前条目数 */
+	virtual int32 Num() const = 0;
+
+	/** 容器占用的堆内存（字节） */
+	virtual SIZE_T GetAllocatedSize() const = 0;
+
+	const TCHAR* GetName() const { return Name; }
+	int32 GetCapacity() const { return Capacity; }
+
+	/** 容量已满时淘汰最久未使用条目的累计次数 */
+	int32 GetNumEvictions() const { return NumEvictions; }
+
+	/** 输出所有缓存的统计 */
+	static void DumpAllCaches(FOutputDevice& Ar);
+
+protected:
+	const TCHAR* Name;
+	int32 Capacity;
+	int32 NumEvictions = 0;
+};
+
+/**
+ * 以Actor为键、固定容量、按最近最少使用淘汰的缓存
+ * 键只保存弱引用，不会阻止Actor被回收；已销毁Actor的条目在访问时、淘汰前以及每次垃圾回收后被清除。
+ * 条目存放在连续数组中并以下标链表维护使用顺序，分配的内存不超过容量。
+ */
+template<typename ValueType>
+class TActorKeyedCache : public FActorKeyedCacheBase
+{
+public:
+	explicit TActorKeyedCache(const TCHAR* InName = TEXT("ActorKeyedCache"), int32 InCapacity = 64)
+		: FActorKeyedCacheBase(InName, FMath::Max(InCapacity, 1))
+	{
+	}
+
+	/** 查找并标记为最近使用；Actor已销毁时移除条目并返回nullptr */
+	ValueType* Find(const AActor* Actor)
+	{
+		const int32 Index = FindIndex(Actor);
+		if (Index == INDEX_NONE)
+			return nullptr;
+
+		if (!Entries[Index].Actor.IsValid())
+		{
+			RemoveAt(Index);
+			return nullptr;
+		}
+
+		MoveToFront(Index);
+		return &Entries[Index].Value;
+	}
+
+	/** 查找但不改变使用顺序 */
+	const ValueType* Peek(const AActor* Actor) const
+	{
+		const int32 Index = FindIndex(Actor);
+		return Index != INDEX_NONE && Entries[Index].Actor.IsValid() ? &Entries[Index].Value : nullptr;
+	}
+
+	bool Contains(const AActor* Actor) const { return Peek(Actor) != nullptr; }
+
+	/** 写入或覆盖条目并标记为最近使用；容量已满时先清除失效条目，仍满则淘汰最久未使用的条目 */
+	ValueType& Add(const AActor* Actor, const ValueType& Value)
+	{
+		check(Actor);
+
+		int32 Index = FindIndex(Actor);
+		if (Index == INDEX_NONE)
+		{
+			LLM_SCOPE_BYTAG(SoulActorCache);
+
+			if (Lookup.Num() >= Capacity)
+			{
+				EvictOne();
+			}
+
+			Index = AllocateEntry();
+			FEntry& Entry = Entries[Index];
+			Entry.Actor = const_cast<AActor*>(Actor);
+			Entry.Key = TObjectKey<AActor>(Actor);
+			Lookup.Add(Entry.Key, Index);
+			LinkFront(Index);
+		}
+		else
+		{
+			MoveToFront(Index);
+		}
+
+		Entries[Index].Value = Value;
+		return Entries[Index].Value;
+	}
+
+	bool Remove(const AActor* Actor)
+	{
+		const int32 Index = FindIndex(Actor);
+		if (Index == INDEX_NONE)
+			return false;
+
+		RemoveAt(Index);
+		return true;
+	}
+
+	/** 清空条目（保留已分配的内存，容量固定故不会继续增长） */
+	void Empty()
+	{
+		Entries.Reset();
+		FreeSlots.Reset();
+		Lookup.Reset();
+		Head = INDEX_NONE;
+		Tail = INDEX_NONE;
+	}
+
+	/** 按最近使用到最久未使用的顺序遍历有效条目：Func(AActor*, const ValueType&) */
+	template<typename FuncType>
+	void ForEach(FuncType&& Func) const
+	{
+		for (int32 Index = Head; Index != INDEX_NONE; Index = Entries[Index].Next)
+		{
+			if (AActor* Actor = Entries[Index].Actor.Get())
+			{
+				Func(Actor, Entries[Index].Value);
+			}
+		}
+	}
+
+	virtual int32 PurgeStale() override
+	{
+		int32 NumRemoved = 0;
+		for (int32 Index = Tail; Index != INDEX_NONE;)
+		{
+			const int32 Prev = Entries[Index].Prev;
+			if (!Entries[Index].Actor.IsValid())
+			{
+				RemoveAt(Index);
+				++NumRemoved;
+			}
+			Index = Prev;
+		}
+		return NumRemoved;
+	}
+
+	virtual int32 Num() const override { return Lookup.Num(); }
+
+	virtual SIZE_T GetAllocatedSize() const override
+	{
+		return Entries.GetAllocatedSize() + FreeSlots.GetAllocatedSize() + Lookup.GetAllocatedSize();
+	}
+
+private:
+	struct FEntry
+	{
+		TWeakObjectPtr<AActor> Actor;
+		TObjectKey<AActor> Key;
+		ValueType Value = ValueType();
+
+		/** 使用顺序链表（Prev指向更近使用的条目） */
+		int32 Prev = INDEX_NONE;
+		int32 Next = INDEX_NONE;
+	};
+
+	int32 FindIndex(const AActor* Actor) const
+	{
+		if (!Actor)
+			return INDEX_NONE;
+
+		const int32* Index = Lookup.Find(TObjectKey<AActor>(Actor));
+		return Index ? *Index : INDEX_NONE;
+	}
+
+	int32 AllocateEntry()
+	{
+		if (FreeSlots.Num() > 0)
+		{
+			return FreeSlots.Pop();
+		}
+
+		if (Entries.Max() < Capacity)
+		{
+			Entries.Reserve(Capacity);
+		}
+		return Entries.AddDefaulted();
+	}
+
+	void RemoveAt(int32 Index)
+	{
+		FEntry& Entry = Entries[Index];
+		Lookup.Remove(Entry.Key);
+		Unlink(Index);
+
+		Entry.Actor.Reset();
+		Entry.Key = TObjectKey<AActor>();
+		Entry.Value = ValueType();
+		FreeSlots.Add(Index);
+	}
+
+	void EvictOne()
+	{
+		if (PurgeStale() > 0)
+			return;
+
+		if (Tail != INDEX_NONE)
+		{
+			RemoveAt(Tail);
+			++NumEvictions;
+		}
+	}
+
+	void LinkFront(int32 Index)
+	{
+		FEntry& Entry = Entries[Index];
+		Entry.Prev = INDEX_NONE;
+		Entry.Next = Head;
+		if (Head != INDEX_NONE)
+		{
+			Entries[Head].Prev = Index;
+		}
+		Head = Index;
+		if (Tail == INDEX_NONE)
+		{
+			Tail = Index;
+		}
+	}
+
+	void Unlink(int32 Index)
+	{
+		FEntry& Entry = Entries[Index];
+		if (Entry.Prev != INDEX_NONE)
+		{
+			Entries[Entry.Prev].Next = Entry.Next;
+		}
+		else
+		{
+			Head = Entry.Next;
+		}
+
+		if (Entry.Next != INDEX_NONE)
+		{
+			Entries[Entry.Next].Prev = Entry.Prev;
+		}
+		else
+		{
+			Tail = Entry.Prev;
+		}
+
+		Entry.Prev = INDEX_NONE;
+		Entry.Next = INDEX_NONE;
+	}
+
+	void MoveToFront(int32 Index)
+	{
+		if (Index == Head)
+			return;
+
+		Unlink(Index);
+		LinkFront(Index);
+	}
+
+	TArray<FEntry> Entries;
+	TArray<int32> FreeSlots;
+	TMap<TObjectKey<AActor>, int32> Lookup;
+
+	/** 最近使用的条目 */
+	int32 Head = INDEX_NONE;
+
+	/** 最久未使用的条目（淘汰对象） */
+	int32 Tail = INDEX_NONE;
+};
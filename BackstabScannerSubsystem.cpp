@@ -0,0 +1,114 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BackstabScannerSubsystem.h"
+#include "ExecutionComponent.h"
+#include "GameFramework/Character.h"
+#include "EngineUtils.h"
+
+void UBackstabScannerSubsystem::RegisterScanner(UExecutionComponent* Scanner)
+{
+	if (Scanner)
+	{
+		Scanners.AddUnique(Scanner);
+	}
+}
+
+void UBackstabScannerSubsystem::UnregisterScanner(UExecutionComponent* Scanner)
+{
+	Scanners.RemoveSwap(Scanner);
+}
+
+void UBackstabScannerSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (Scanners.Num() == 0)
+		return;
+
+	TimeUntilNextScan -= DeltaTime;
+	if (TimeUntilNextScan > 0.0f)
+		return;
+
+	TimeUntilNextScan = SCAN_INTERVAL;
+	RunScan();
+}
+
+TStatId UBackstabScannerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UBackstabScannerSubsystem, STATGROUP_Tickables);
+}
+
+bool UBackstabScannerSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UBackstabScannerSubsystem::RunScan()
+{
+	// 清理失效的扫描者，并以最大背刺距离作为网格单元，保证3x3邻域覆盖所有扫描者的范围
+	float MaxRange = 0.0f;
+	for (int32 Index = Scanners.Num() - 1; Index >= 0; --Index)
+	{
+		UExecutionComponent* Scanner = Scanners[Index].Get();
+		if (!Scanner)
+		{
+			Scanners.RemoveAtSwap(Index);
+			continue;
+		}
+		MaxRange = FMath::Max(MaxRange, Scanner->ExecutionSettings.BackstabRange);
+	}
+
+	if (Scanners.Num() == 0 || MaxRange <= 0.0f)
+		return;
+
+	CellSize = MaxRange;
+
+	// 共享的邻近查询：整个世界只遍历一次角色
+	Grid.Reset();
+	Characters.Reset();
+	for (TActorIterator<ACharacter> It(GetWorld()); It; ++It)
+	{
+		ACharacter* Character = *It;
+		if (!IsValid(Character))
+			continue;
+
+		const int32 CharacterIndex = Characters.Add(Character);
+		Grid.FindOrAdd(GetCell(Character->GetActorLocation())).Add(CharacterIndex);
+	}
+
+	// 逐个扫描者批量判定相邻单元内的角色
+	// 事件回调中可能注销扫描者，按索引遍历
+	for (int32 ScannerIndex = 0; ScannerIndex < Scanners.Num(); ++ScannerIndex)
+	{
+		UExecutionComponent* Scanner = Scanners[ScannerIndex].Get();
+		AActor* ScannerOwner = Scanner ? Scanner->GetOwner() : nullptr;
+		if (!ScannerOwner)
+			continue;
+
+		NearbyScratch.Reset();
+		const FIntPoint Center = GetCell(ScannerOwner->GetActorLocation());
+		for (int32 OffsetY = -1; OffsetY <= 1; ++OffsetY)
+		{
+			for (int32 OffsetX = -1; OffsetX <= 1; ++OffsetX)
+			{
+				if (const TArray<int32>* Cell = Grid.Find(Center + FIntPoint(OffsetX, OffsetY)))
+				{
+					for (int32 CharacterIndex : *Cell)
+					{
+						if (Characters[CharacterIndex] != ScannerOwner)
+						{
+							NearbyScratch.Add(Characters[CharacterIndex]);
+						}
+					}
+				}
+			}
+		}
+
+		Scanner->UpdateBackstabOpportunity(NearbyScratch);
+	}
+}
+
+FIntPoint UBackstabScannerSubsystem::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
@@ -0,0 +1,54 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "BackstabScannerSubsystem.generated.h"
+
+class ACharacter;
+class UExecutionComponent;
+
+/**
+ * 背刺机会扫描子系统
+ * 每次扫描只遍历一次场景中的角色并放入平面网格（单元边长取所有扫描者中最大的背刺距离），
+ * 每个处决组件只拿到相邻单元内的角色做批量判定，开销随附近的角色对数增长，而不是角色数乘以Actor数。
+ */
+UCLASS()
+class SOUL_API UBackstabScannerSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** 扫描间隔（秒） */
+	static constexpr float SCAN_INTERVAL = 0.2f;
+
+	/** 注册/注销处决组件（BeginPlay/EndPlay调用） */
+	void RegisterScanner(UExecutionComponent* Scanner);
+	void UnregisterScanner(UExecutionComponent* Scanner);
+
+	// UTickableWorldSubsystem
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** 一次共享扫描：重建网格并把邻近角色交给每个扫描者 */
+	void RunScan();
+
+	FIntPoint GetCell(const FVector& Location) const;
+
+	TArray<TWeakObjectPtr<UExecutionComponent>> Scanners;
+
+	/** 本次扫描的网格（单元 -> 角色索引） */
+	TMap<FIntPoint, TArray<int32>> Grid;
+	TArray<ACharacter*> Characters;
+
+	/** 交给单个扫描者的邻近角色（复用） */
+	TArray<ACharacter*> NearbyScratch;
+
+	float CellSize = 300.0f;
+	float TimeUntilNextScan = 0.0f;
+};
@@ -13,6 +13,11 @@
 #include "DrawDebugHelpers.h"
 #include "HAL/IConsoleManager.h"
 #include "UObject/UObjectIterator.h"
+#include "EnemyCameraConfigComponent.h"
+#include "PerformanceProfiler.h"
+#include "DebugManager.h"
+#include "SoulPlayerCameraManager.h"
+#include "TargetDetectionComponent.h"
 
 // 控制台命令定义
 static TAutoConsoleVariable<int32> CVarCameraDebugLevel(
@@ -180,6 +185,9 @@ void UCameraControlComponent::BeginPlay()
 		UE_LOG(LogTemp, Warning, TEXT("CameraControlComponent: No CameraComponent found on owner. Camera control may not work properly."));
 	}
 
+	// 地形高度缓存以拥有者为中心采样
+	TerrainHeightCache.Initialize(OwnerCharacter);
+
 	// 记录SpringArm原始长度用于动态调整
 	if (SpringArm)
 	{
@@ -194,6 +202,9 @@ void UCameraControlComponent::BeginPlay()
 	// 设置初始相机状态
 	UpdateCameraState(ECameraState::Normal);
 
+	// 缓存性能分析子系统，质量指标采样时不再逐帧查找
+	QualityProfiler = UPerformanceProfiler::GetPerformanceProfiler(this);
+
 	if (bEnableCameraDebugLogs)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("CameraControlComponent: Successfully initialized for %s"), 
@@ -209,7 +220,10 @@ void UCameraControlComponent::TickComponent(float DeltaTime, ELevelTick TickType
 	// 应用控制台变量
 	if (CVarCameraInterpSpeed.GetValueOnGameThread() != CameraSettings.CameraInterpSpeed)
 	{
-		CameraSettings.CameraInterpSpeed = CVarCameraInterpSpeed.GetValueOnGameThread();
+		// 经由设置接口修改，编译后的共享设置随之重建
+		FCameraSettings UpdatedSettings = CameraSettings;
+		UpdatedSettings.CameraInterpSpeed = CVarCameraInterpSpeed.GetValueOnGameThread();
+		SetCameraSettings(UpdatedSettings);
 	}
 	
 	// 检查Debug级别
@@ -247,22 +261,32 @@ void UCameraControlComponent::TickComponent(float DeltaTime, ELevelTick TickType
 		}
 	}
 
-	// 每帧调试信息输出
-	if (bEnableCameraDebugLogs && CurrentLockOnTarget)
+	// 拉取异步遮挡检测结果并平滑遮挡系数，再驱动相机臂长度
+	UpdateOcclusionCache(DeltaTime);
+	UpdateSpringArmOcclusion();
+
+	// 锁定期间维护地形高度缓存（地形补偿改为查表）
+	if (CurrentLockOnTarget && AdvancedCameraSettings.bEnableTerrainHeightCompensation)
 	{
-		static float LastDebugTime = 0.0f;
-		float CurrentTime = GetWorld()->GetTimeSeconds();
-		if (CurrentTime - LastDebugTime > 2.0f) // 每2秒输出一次
+		if (ACharacter* OwnerCharacter = GetOwnerCharacter())
 		{
-			// 输出调试信息
-			// UE_LOG(LogTemp, VeryVerbose, TEXT("CameraControl: State=%s, Target=%s, Follow=%s, Rotate=%s"), 
-			//	*UEnum::GetValueAsString(CurrentCameraState),
-			//	*CurrentLockOnTarget->GetName(),
-			//	bShouldCameraFollowTarget ? TEXT("YES") : TEXT("NO"),
-			//	bShouldCharacterRotateToTarget ? TEXT("YES") : TEXT("NO"));
-			LastDebugTime = CurrentTime;
+			TerrainHeightCache.Tick(OwnerCharacter->GetActorLocation());
 		}
 	}
+
+	// 相机质量指标（与耗时数据一起统计）
+	UpdateCameraQualityMetrics(DeltaTime);
+
+	// 每帧调试信息输出
+	if (bEnableCameraDebugLogs && CurrentLockOnTarget)
+	{
+		// 每2秒输出一次
+		SOUL_LOG_VERY_VERBOSE_RATE_LIMITED(Camera, 2.0, TEXT("CameraControl: State=%s, Target=%s, Follow=%s, Rotate=%s"), 
+			*UEnum::GetValueAsString(CurrentCameraState),
+			*CurrentLockOnTarget->GetName(),
+			bShouldCameraFollowTarget ? TEXT("YES") : TEXT("NO"),
+			bShouldCharacterRotateToTarget ? TEXT("YES") : TEXT("NO"));
+	}
 }
 
 // ==================== 接口函数实现 ====================
@@ -278,6 +302,10 @@ void UCameraControlComponent::SetCameraSettings(const FCameraSettings& Settings)
 		UE_LOG(LogTemp, Log, TEXT("- SmoothTracking: %s"), CameraSettings.bEnableSmoothCameraTracking ? TEXT("ON") : TEXT("OFF"));
 		UE_LOG(LogTemp, Log, TEXT("- TrackingMode: %d"), CameraSettings.CameraTrackingMode);
 	}
+	
+	// 通知拥有者重建编译后的共享设置（没有拥有者分发时下次读取按新配置重建）
+	CompiledSettings.Reset();
+	OnCameraSettingsChanged.Broadcast();
 }
 
 void UCameraControlComponent::SetAdvancedCameraSettings(const FAdvancedCameraSettings& Settings)
@@ -291,6 +319,27 @@ void UCameraControlComponent::SetAdvancedCameraSettings(const FAdvancedCameraSet
 		UE_LOG(LogTemp, Log, TEXT("- TerrainCompensation: %s"), AdvancedCameraSettings.bEnableTerrainHeightCompensation ? TEXT("ON") : TEXT("OFF"));
 		UE_LOG(LogTemp, Log, TEXT("- EnemySizeAdaptation: %s"), AdvancedCameraSettings.bEnableEnemySizeAdaptation ? TEXT("ON") : TEXT("OFF"));
 	}
+	
+	// 通知拥有者重建编译后的共享设置（没有拥有者分发时下次读取按新配置重建）
+	CompiledSettings.Reset();
+	OnCameraSettingsChanged.Broadcast();
+}
+
+void UCameraControlComponent::SetCompiledSettings(TSharedPtr<const FCompiledLockOnSettings> InCompiledSettings)
+{
+	CompiledSettings = InCompiledSettings;
+}
+
+const FCompiledLockOnSettings& UCameraControlComponent::GetCompiledSettings() const
+{
+	// 未由拥有者分发时，按拥有者目标检测组件的锁定设置与本组件的相机设置构建一次
+	if (!CompiledSettings.IsValid())
+	{
+		const UTargetDetectionComponent* TargetDetection = GetOwner() ? GetOwner()->FindComponentByClass<UTargetDetectionComponent>() : nullptr;
+		CompiledSettings = FCompiledLockOnSettings::Build(TargetDetection ? TargetDetection->LockOnSettings : FLockOnSettings(),
+			CameraSettings, AdvancedCameraSettings);
+	}
+	return *CompiledSettings;
 }
 
 // ==================== 状态更新和切换函数 ====================
@@ -428,12 +477,20 @@ void UCameraControlComponent::UpdateLockOnCamera()
 		return;
 	}
 
+	// 延迟求解生效时由相机管理器在所有移动完成后调用
+	if (!bIsInLateLockOnSolve && IsLateLockOnSolveActive())
+	{
+		return;
+	}
+
 	APlayerController* PlayerController = GetOwnerController();
 	if (!PlayerController)
 	{
 		return;
 	}
 
+	SOUL_PERFORMANCE_SCOPE(TEXT("CameraControl::UpdateLockOnCamera"));
+
 	// 只有在应该跟随目标时才更新相机
 	if (!bShouldCameraFollowTarget)
 	{
@@ -531,6 +588,42 @@ void UCameraControlComponent::UpdateLockOnCamera()
 	}
 }
 
+bool UCameraControlComponent::IsLateLockOnSolveActive() const
+{
+	if (!bUseLateLockOnSolve)
+		return false;
+
+	APlayerController* PlayerController = GetOwnerController();
+	if (!PlayerController || !PlayerController->PlayerCameraManager)
+		return false;
+
+	// 只有自定义相机管理器且以本角色为视图目标时才会回调延迟求解
+	return PlayerController->PlayerCameraManager->IsA<ASoulPlayerCameraManager>()
+		&& PlayerController->PlayerCameraManager->GetViewTarget() == GetOwner();
+}
+
+bool UCameraControlComponent::SolveLateLockOnCamera()
+{
+	if (!CurrentLockOnTarget || !IsValid(CurrentLockOnTarget))
+		return false;
+
+	// 平滑切换与自动修正仍由Tick驱动
+	if (bIsSmoothSwitching || bIsCameraAutoCorrection)
+		return false;
+
+	APlayerController* PlayerController = GetOwnerController();
+	if (!PlayerController)
+		return false;
+
+	const FRotator PreviousRotation = PlayerController->GetControlRotation();
+
+	bIsInLateLockOnSolve = true;
+	UpdateLockOnCamera();
+	bIsInLateLockOnSolve = false;
+
+	return !PlayerController->GetControlRotation().Equals(PreviousRotation, KINDA_SMALL_NUMBER);
+}
+
 void UCameraControlComponent::StartSmoothTargetSwitch(AActor* NewTarget)
 {
 	// === 步骤3修复：保留DEADZONE逻辑 + 修复漂移 ===
@@ -664,6 +757,11 @@ void UCameraControlComponent::UpdateSmoothTargetSwitch()
 
 		bIsSmoothSwitching = false;
 
+		if (UPerformanceProfiler* Profiler = GetQualityProfiler())
+		{
+			Profiler->RecordCameraMetric(ECameraQualityMetric::SwitchCompletion, ElapsedTime);
+		}
+
 		if (bEnableCameraDebugLogs)
 		{
 			UE_LOG(LogTemp, Log, TEXT("Smooth target switch completed: %s"), *CurrentLockOnTarget->GetName());
@@ -701,6 +799,12 @@ void UCameraControlComponent::SetLockOnTarget(AActor* Target)
 	AActor* OldTarget = CurrentLockOnTarget;
 	CurrentLockOnTarget = Target;
 	
+	// 目标变化后旧的遮挡缓存不再适用
+	OcclusionCache.Invalidate();
+	
+	// 开始统计相机对准新目标的耗时
+	LockOnAcquireStartTime = Target ? GetWorld()->GetTimeSeconds() : -1.0f;
+	
 	// 只在真正改变时记录日志
 	if (bEnableCameraDebugLogs)
 	{
@@ -727,6 +831,10 @@ void UCameraControlComponent::ClearLockOnTarget()
 	
 	PreviousLockOnTarget = CurrentLockOnTarget;
 	CurrentLockOnTarget = nullptr;
+	OcclusionCache.Invalidate();
+	ProfiledTarget.Reset();
+	ProfileSource.Reset();
+	LockOnAcquireStartTime = -1.0f;
 	
 	bIsSmoothSwitching = false;
 	bShouldSmoothSwitchCamera = false;
@@ -1029,7 +1137,7 @@ void UCameraControlComponent::UpdateAdvancedCameraAdjustment()
 	
 	LastAdvancedAdjustmentTime = CurrentTime;
 	
-	EEnemySizeCategory SizeCategory = GetTargetSizeCategoryV2(CurrentLockOnTarget);
+	EEnemySizeCategory SizeCategory = GetTargetCameraProfile(CurrentLockOnTarget).SizeCategory;
 	float Distance = CalculateDistanceToTarget(CurrentLockOnTarget);
 	
 	FVector AdjustedLocation = CalculateAdvancedTargetLocation(CurrentLockOnTarget, SizeCategory, Distance);
@@ -1183,18 +1291,42 @@ EEnemySizeCategory UCameraControlComponent::GetTargetSizeCategoryV2(AActor* Targ
 	FVector Origin, BoxExtent;
 	Target->GetActorBounds(false, Origin, BoxExtent);
 	
-	float Height = BoxExtent.Z * 2.0f;
-	float Volume = BoxExtent.X * BoxExtent.Y * BoxExtent.Z * 8.0f;
+	return UEnemyCameraConfigComponent::ClassifySizeFromExtent(BoxExtent);
+}
+
+const FResolvedEnemyCameraProfile& UCameraControlComponent::GetTargetCameraProfile(AActor* Target) const
+{
+	// 目标变化（或其配置组件已销毁）时才重新解析句柄
+	if (Target != ProfiledTarget.Get() || (bProfileFromComponent && !ProfileSource.IsValid()))
+	{
+		ProfiledTarget = Target;
+		ProfileSource = Target ? Target->FindComponentByClass<UEnemyCameraConfigComponent>() : nullptr;
+		bProfileFromComponent = ProfileSource.IsValid();
+		
+		if (!bProfileFromComponent || !ProfileSource->GetResolvedProfile().bIsResolved)
+		{
+			// 没有配置组件：按包围盒分类一次，取默认体型配置
+			FallbackProfile = FResolvedEnemyCameraProfile();
+			FallbackProfile.SizeCategory = GetTargetSizeCategoryV2(Target);
+			FallbackProfile.CameraType = GetEnemyCameraTypeFromActor(Target);
+			if (const FCameraTypeConfig* TypeConfig = CameraTypeConfigs.Find(FallbackProfile.CameraType))
+			{
+				FallbackProfile.Config = *TypeConfig;
+			}
+			FallbackProfile.bIsResolved = Target != nullptr;
+		}
+	}
+	
+	if (const UEnemyCameraConfigComponent* Source = ProfileSource.Get())
+	{
+		const FResolvedEnemyCameraProfile& Profile = Source->GetResolvedProfile();
+		if (Profile.bIsResolved)
+		{
+			return Profile;
+		}
+	}
 	
-	// 基于体积和高度的分类
-	if (Height > 500.0f || Volume > 1000000.0f)
-		return EEnemySizeCategory::Giant;
-	else if (Height > 300.0f || Volume > 300000.0f)
-		return EEnemySizeCategory::Large;
-	else if (Height > 150.0f || Volume > 100000.0f)
-		return EEnemySizeCategory::Medium;
-	else
-		return EEnemySizeCategory::Small;
+	return FallbackProfile;
 }
 
 float UCameraControlComponent::CalculateDistanceToTarget(AActor* Target) const
@@ -1312,7 +1444,18 @@ bool UCameraControlComponent::IsOwnerOccludingSocket(const FVector& SocketWorldL
 		return false;
 	
 	FVector CameraLocation = Camera->GetComponentLocation();
-	FVector DirectionToSocket = (SocketWorldLocation - CameraLocation).GetSafeNormal();
+	FVector PlayerLocation = OwnerCharacter->GetActorLocation();
+	
+	// 仍在有效体积内：直接使用缓存结果，并按间隔发起异步检测刷新
+	// 接近体积边缘时立即刷新，使缓存在移动中失效前重新居中，避免回退到同步检测
+	if (IsOcclusionCacheValid(CameraLocation, SocketWorldLocation, PlayerLocation))
+	{
+		const bool bNearEdge = !IsOcclusionCacheValid(CameraLocation, SocketWorldLocation, PlayerLocation, OCCLUSION_CACHE_REFRESH_RADIUS);
+		RequestAsyncOcclusionTrace(CameraLocation, SocketWorldLocation, PlayerLocation, bNearEdge);
+		return OcclusionCache.bOccluded;
+	}
+	
+	// 相机、目标或玩家已离开有效体积：同步重新检测并重建缓存
 	float DistanceToSocket = FVector::Dist(CameraLocation, SocketWorldLocation);
 	
 	FHitResult HitResult;
@@ -1327,7 +1470,166 @@ bool UCameraControlComponent::IsOwnerOccludingSocket(const FVector& SocketWorldL
 		QueryParams
 	);
 	
-	return bHit && HitResult.Distance < DistanceToSocket * 0.5f;
+	OcclusionCache.CameraLocation = CameraLocation;
+	OcclusionCache.SocketLocation = SocketWorldLocation;
+	OcclusionCache.PlayerLocation = PlayerLocation;
+	OcclusionCache.HitDistance = bHit ? HitResult.Distance : DistanceToSocket;
+	OcclusionCache.bOccluded = bHit && HitResult.Distance < DistanceToSocket * 0.5f;
+	OcclusionCache.bHasResult = true;
+	OcclusionCache.LastAsyncTraceTime = GetWorld()->GetTimeSeconds();
+	
+	// 同步结果已覆盖旧的异步请求
+	OcclusionCache.PendingTrace = FTraceHandle();
+	
+	return OcclusionCache.bOccluded;
+}
+
+bool UCameraControlComponent::IsOcclusionCacheValid(const FVector& CameraLocation, const FVector& SocketLocation, const FVector& PlayerLocation, float Radius) const
+{
+	if (!OcclusionCache.bHasResult)
+		return false;
+	
+	const float RadiusSquared = Radius * Radius;
+	return FVector::DistSquared(CameraLocation, OcclusionCache.CameraLocation) <= RadiusSquared
+		&& FVector::DistSquared(SocketLocation, OcclusionCache.SocketLocation) <= RadiusSquared
+		&& FVector::DistSquared(PlayerLocation, OcclusionCache.PlayerLocation) <= RadiusSquared;
+}
+
+void UCameraControlComponent::RequestAsyncOcclusionTrace(const FVector& CameraLocation, const FVector& SocketLocation, const FVector& PlayerLocation, bool bImmediate) const
+{
+	UWorld* World = GetWorld();
+	if (!World || OcclusionCache.PendingTrace.IsValid())
+		return;
+	
+	float CurrentTime = World->GetTimeSeconds();
+	if (!bImmediate && CurrentTime - OcclusionCache.LastAsyncTraceTime < OCCLUSION_ASYNC_INTERVAL)
+		return;
+	
+	FCollisionQueryParams QueryParams;
+	QueryParams.AddIgnoredActor(GetOwner());
+	
+	OcclusionCache.PendingTrace = World->AsyncLineTraceByChannel(
+		EAsyncTraceType::Single,
+		CameraLocation,
+		SocketLocation,
+		ECC_Visibility,
+		QueryParams
+	);
+	OcclusionCache.PendingCameraLocation = CameraLocation;
+	OcclusionCache.PendingSocketLocation = SocketLocation;
+	OcclusionCache.PendingPlayerLocation = PlayerLocation;
+	OcclusionCache.LastAsyncTraceTime = CurrentTime;
+}
+
+UPerformanceProfiler* UCameraControlComponent::GetQualityProfiler() const
+{
+	UPerformanceProfiler* Profiler = QualityProfiler.Get();
+	return Profiler && Profiler->IsPerformanceMonitoringEnabled() ? Profiler : nullptr;
+}
+
+void UCameraControlComponent::UpdateCameraQualityMetrics(float DeltaTime)
+{
+	UPerformanceProfiler* Profiler = GetQualityProfiler();
+	APlayerController* PlayerController = GetOwnerController();
+	if (!Profiler || !PlayerController || DeltaTime <= KINDA_SMALL_NUMBER)
+	{
+		MetricHistoryFrames = 0;
+		return;
+	}
+	
+	// 角速度与角加加速度
+	FRotator CurrentRotation = PlayerController->GetControlRotation();
+	if (MetricHistoryFrames > 0)
+	{
+		float AngleDelta = FMath::RadiansToDegrees(CurrentRotation.Quaternion().AngularDistance(LastMetricRotation.Quaternion()));
+		float AngularVelocity = AngleDelta / DeltaTime;
+		float AngularAcceleration = (AngularVelocity - LastAngularVelocity) / DeltaTime;
+		
+		Profiler->RecordCameraMetric(ECameraQualityMetric::AngularVelocity, AngularVelocity);
+		if (MetricHistoryFrames > 2)
+		{
+			float AngularJerk = FMath::Abs(AngularAcceleration - LastAngularAcceleration) / DeltaTime;
+			Profiler->RecordCameraMetric(ECameraQualityMetric::AngularJerk, AngularJerk);
+		}
+		
+		LastAngularAcceleration = AngularAcceleration;
+		LastAngularVelocity = AngularVelocity;
+	}
+	LastMetricRotation = CurrentRotation;
+	++MetricHistoryFrames;
+	
+	if (!CurrentLockOnTarget || !IsValid(CurrentLockOnTarget))
+		return;
+	
+	FVector TargetLocation = CurrentLockOnTarget->GetActorLocation();
+	
+	// 目标偏离屏幕中心（归一化到屏幕半宽/半高）
+	FVector2D ScreenPosition;
+	int32 ViewportSizeX = 0;
+	int32 ViewportSizeY = 0;
+	PlayerController->GetViewportSize(ViewportSizeX, ViewportSizeY);
+	if (ViewportSizeX > 0 && ViewportSizeY > 0 && PlayerController->ProjectWorldLocationToScreen(TargetLocation, ScreenPosition))
+	{
+		FVector2D HalfSize(ViewportSizeX * 0.5f, ViewportSizeY * 0.5f);
+		FVector2D Offset = (ScreenPosition - HalfSize) / HalfSize;
+		Profiler->RecordCameraMetric(ECameraQualityMetric::ScreenOffset, Offset.Size());
+	}
+	
+	// 锁定后首次对准目标的耗时
+	if (LockOnAcquireStartTime >= 0.0f)
+	{
+		FVector ViewLocation;
+		FRotator ViewRotation;
+		PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+		
+		FVector ToTarget = (TargetLocation - ViewLocation).GetSafeNormal();
+		float AngleToTarget = FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(FVector::DotProduct(ViewRotation.Vector(), ToTarget), -1.0f, 1.0f)));
+		if (AngleToTarget <= ACQUIRE_ANGLE_THRESHOLD)
+		{
+			Profiler->RecordCameraMetric(ECameraQualityMetric::TimeToAcquire, GetWorld()->GetTimeSeconds() - LockOnAcquireStartTime);
+			LockOnAcquireStartTime = -1.0f;
+		}
+	}
+}
+
+void UCameraControlComponent::UpdateOcclusionCache(float DeltaTime)
+{
+	UWorld* World = GetWorld();
+	if (!World)
+		return;
+	
+	// 没有锁定目标时缓存失效，遮挡系数回落
+	if (!CurrentLockOnTarget)
+	{
+		OcclusionCache.Invalidate();
+	}
+	
+	// 拉取上一帧发起的异步检测结果
+	if (OcclusionCache.PendingTrace.IsValid())
+	{
+		FTraceDatum TraceDatum;
+		if (World->QueryTraceData(OcclusionCache.PendingTrace, TraceDatum))
+		{
+			float DistanceToSocket = FVector::Dist(OcclusionCache.PendingCameraLocation, OcclusionCache.PendingSocketLocation);
+			const FHitResult* Hit = FHitResult::GetFirstBlockingHit(TraceDatum.OutHits);
+			
+			OcclusionCache.CameraLocation = OcclusionCache.PendingCameraLocation;
+			OcclusionCache.SocketLocation = OcclusionCache.PendingSocketLocation;
+			OcclusionCache.PlayerLocation = OcclusionCache.PendingPlayerLocation;
+			OcclusionCache.HitDistance = Hit ? Hit->Distance : DistanceToSocket;
+			OcclusionCache.bOccluded = Hit && Hit->Distance < DistanceToSocket * 0.5f;
+			OcclusionCache.bHasResult = true;
+			OcclusionCache.PendingTrace = FTraceHandle();
+		}
+		else if (!World->IsTraceHandleValid(OcclusionCache.PendingTrace, false))
+		{
+			// 句柄已过期（结果未及时拉取），下次查询重新发起
+			OcclusionCache.PendingTrace = FTraceHandle();
+		}
+	}
+	
+	float TargetFactor = (OcclusionCache.bHasResult && OcclusionCache.bOccluded) ? 1.0f : 0.0f;
+	SmoothedOcclusionFactor = FMath::FInterpTo(SmoothedOcclusionFactor, TargetFactor, DeltaTime, OCCLUSION_SMOOTH_SPEED);
 }
 
 void UCameraControlComponent::AdjustSpringArmForSizeDistance(EEnemySizeCategory SizeCategory, float Distance, float BoundingHeight)
@@ -1367,6 +1669,39 @@ void UCameraControlComponent::AdjustSpringArmForSizeDistance(EEnemySizeCategory
 	bArmLengthAdjusted = true;
 }
 
+void UCameraControlComponent::UpdateSpringArmOcclusion()
+{
+	USpringArmComponent* SpringArm = GetSpringArmComponent();
+	if (!SpringArm || BaseArmLength <= 0.0f || bIsPreviewingCamera)
+		return;
+	
+	// 锁定期间每帧查询：缓存有效时直接返回并按间隔发起异步刷新，离开有效体积时同步重新检测
+	const bool bHasTarget = CurrentLockOnTarget && IsValid(CurrentLockOnTarget);
+	if (bHasTarget)
+	{
+		IsOwnerOccludingSocket(GetOptimalLockOnPosition(CurrentLockOnTarget));
+	}
+	else if (!bOcclusionArmActive)
+	{
+		// 未锁定且系数已回落：不干预其他逻辑设置的相机臂长度
+		return;
+	}
+	
+	// 开始驱动时或臂长被外部修改（锁定臂长倍率、按体型的相机配置等）时，捕获该长度作为无遮挡长度
+	if (!bOcclusionArmActive || !FMath::IsNearlyEqual(SpringArm->TargetArmLength, LastOcclusionArmLength))
+	{
+		UnoccludedArmLength = SpringArm->TargetArmLength;
+	}
+	
+	bOcclusionArmActive = bHasTarget || SmoothedOcclusionFactor > KINDA_SMALL_NUMBER;
+	
+	// 系数已平滑，直接按系数缩放即可连续变化；释放后恢复捕获的长度
+	SpringArm->TargetArmLength = bOcclusionArmActive
+		? UnoccludedArmLength * FMath::Lerp(1.0f, OCCLUDED_ARM_LENGTH_SCALE, SmoothedOcclusionFactor)
+		: UnoccludedArmLength;
+	LastOcclusionArmLength = SpringArm->TargetArmLength;
+}
+
 // ==================== 私有辅助函数实现 ====================
 
 void UCameraControlComponent::PerformCameraInterpolation(const FRotator& TargetRotation, float InterpSpeed)
@@ -1423,6 +1758,18 @@ FVector UCameraControlComponent::ApplyTerrainHeightCompensation(const FVector& B
 	
 	float PlayerZ = OwnerCharacter->GetActorLocation().Z;
 	float TargetZ = Target->GetActorLocation().Z;
+	
+	// 优先比较双方脚下的地面高度（地形高度缓存查表），缓存未就绪时回退为Actor高度
+	float PlayerGroundZ = 0.0f;
+	float TargetGroundZ = 0.0f;
+	bool bHasPlayerGround = TerrainHeightCache.GetGroundHeight(OwnerCharacter->GetActorLocation(), PlayerGroundZ);
+	bool bHasTargetGround = TerrainHeightCache.GetGroundHeight(Target->GetActorLocation(), TargetGroundZ);
+	if (bHasPlayerGround && bHasTargetGround)
+	{
+		PlayerZ = PlayerGroundZ;
+		TargetZ = TargetGroundZ;
+	}
+	
 	float HeightDiff = TargetZ - PlayerZ;
 	
 	// 如果目标更高，稍微降低锁定点
@@ -1516,7 +1863,7 @@ FVector UCameraControlComponent::GetOptimalLockOnPosition(AActor* Target) const
 	if (!Target)
 		return FVector::ZeroVector;
 	
-	EEnemySizeCategory SizeCategory = GetTargetSizeCategoryV2(Target);
+	EEnemySizeCategory SizeCategory = GetTargetCameraProfile(Target).SizeCategory;
 	FVector BaseLocation = GetTargetBoundsCenter(Target);
 	FVector SizeOffset = CalculateSizeBasedOffset(Target, SizeCategory);
 	
@@ -1525,13 +1872,9 @@ FVector UCameraControlComponent::GetOptimalLockOnPosition(AActor* Target) const
 	// 新代码：加入配置的偏移
 	FVector FinalLocation = BaseLocation + SizeOffset + CameraSettings.TargetLocationOffset;
 	
-	// 验证日志（用于确认修复生效）
-	static int32 LogCounter = 0;
-	if (LogCounter++ % 60 == 0) // 每60帧记录一次，避免日志爆炸
-	{
-		UE_LOG(LogTemp, Warning, TEXT("GetOptimalLockOnPosition: Applied TargetLocationOffset = %s"), 
-			*CameraSettings.TargetLocationOffset.ToString());
-	}
+	// 验证日志（用于确认修复生效，默认关闭）
+	SOUL_LOG_VERY_VERBOSE_RATE_LIMITED(Camera, 1.0, TEXT("GetOptimalLockOnPosition: Applied TargetLocationOffset = %s"), 
+		*CameraSettings.TargetLocationOffset.ToString());
 	
 	// 如果启用了高级设置，应用额外的偏移
 	if (AdvancedCameraSettings.bEnableEnemySizeAdaptation)
@@ -1554,11 +1897,8 @@ FVector UCameraControlComponent::GetOptimalLockOnPosition(AActor* Target) const
 		FinalLocation += AdditionalOffset;
 		
 		// 验证日志
-		if (LogCounter % 60 == 0)
-		{
-			UE_LOG(LogTemp, Warning, TEXT("GetOptimalLockOnPosition: Applied size offset for %s"), 
-				*UEnum::GetValueAsString(SizeCategory));
-		}
+		SOUL_LOG_VERY_VERBOSE_RATE_LIMITED(Camera, 1.0, TEXT("GetOptimalLockOnPosition: Applied size offset for %s"), 
+			*UEnum::GetValueAsString(SizeCategory));
 	}
 	
 	return FinalLocation;
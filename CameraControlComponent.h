@@ -5,6 +5,8 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "LockOnConfig.h"
+#include "WorldCollision.h"
+#include "TerrainHeightCache.h"
 #include "CameraControlComponent.generated.h"
 
 // 前向声明
@@ -13,6 +15,8 @@ class APlayerController;
 class USpringArmComponent;
 class UCameraComponent;
 class USphereComponent;
+class UEnemyCameraConfigComponent;
+class UPerformanceProfiler;
 
 // 相机状态枚举
 UENUM(BlueprintType)
@@ -141,12 +145,12 @@ public:
 	FOnAdvancedCameraAdjusted OnCameraAdjusted;
 
 	// ==================== 配置参数 ====================
-	/** 基础相机设置 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera Settings")
+	/** 基础相机设置（运行时通过SetCameraSettings修改） */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Camera Settings")
 	FCameraSettings CameraSettings;
 
-	/** 高级相机设置 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Advanced Camera Settings")
+	/** 高级相机设置（运行时通过SetAdvancedCameraSettings修改） */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Advanced Camera Settings")
 	FAdvancedCameraSettings AdvancedCameraSettings;
 
 	/** FreeLook设置 */
@@ -161,6 +165,20 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "FreeLook")
 	void ResetFreeLook();
 
+	// ==================== 延迟相机求解 ====================
+	/** 锁定相机求解推迟到ASoulPlayerCameraManager::UpdateViewTarget（所有移动完成后）执行；控制器未使用该相机管理器时回退到Tick求解 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera Settings")
+	bool bUseLateLockOnSolve = true;
+
+	/** 延迟求解当前是否生效 */
+	bool IsLateLockOnSolveActive() const;
+
+	/**
+	 * 执行延迟锁定求解（由相机管理器在UpdateViewTarget中调用）
+	 * @return 控制器旋转被改写时返回true
+	 */
+	bool SolveLateLockOnCamera();
+
 	// ==================== 调试控制 ====================
 	/** 是否启用相机调试日志 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug")
@@ -280,6 +298,108 @@ protected:
 	// 是否已调整相机臂（避免多次重复动态调整）
 	bool bArmLengthAdjusted = false;
 
+	// 遮挡缩放前的相机臂长度（锁定开始或外部设置臂长时捕获，释放后恢复）
+	float UnoccludedArmLength = 0.0f;
+
+	// 上次由遮挡缩放写入的相机臂长度，用于识别外部对臂长的修改
+	float LastOcclusionArmLength = 0.0f;
+
+	// 遮挡系数正在驱动相机臂（解除锁定后持续到系数回落为0）
+	bool bOcclusionArmActive = false;
+
+	// ==================== 相机遮挡缓存 ====================
+	/** 遮挡检测的时间相干缓存：保留上次结果及其有效体积 */
+	struct FOcclusionCache
+	{
+		/** 有效体积中心：建立缓存时的相机、Socket、玩家位置 */
+		FVector CameraLocation = FVector::ZeroVector;
+		FVector SocketLocation = FVector::ZeroVector;
+		FVector PlayerLocation = FVector::ZeroVector;
+
+		/** 上次检测结果 */
+		bool bHasResult = false;
+		bool bOccluded = false;
+		float HitDistance = 0.0f;
+
+		/** 进行中的异步检测及其发起位置 */
+		FTraceHandle PendingTrace;
+		FVector PendingCameraLocation = FVector::ZeroVector;
+		FVector PendingSocketLocation = FVector::ZeroVector;
+		FVector PendingPlayerLocation = FVector::ZeroVector;
+
+		/** 上次发起异步检测的时间 */
+		float LastAsyncTraceTime = 0.0f;
+
+		void Invalidate()
+		{
+			bHasResult = false;
+			bOccluded = false;
+			PendingTrace = FTraceHandle();
+		}
+	};
+
+	/** 遮挡缓存（IsOwnerOccludingSocket为const查询，故为mutable） */
+	mutable FOcclusionCache OcclusionCache;
+
+	/** 平滑后的遮挡系数（0=无遮挡，1=被遮挡），供相机臂长度逻辑使用 */
+	float SmoothedOcclusionFactor = 0.0f;
+
+	/** 有效体积半径：相机、目标或玩家移出该范围时同步重新检测 */
+	static constexpr float OCCLUSION_CACHE_RADIUS = 100.0f;
+
+	/** 提前刷新半径：偏移超过该范围时立即发起异步检测，使缓存在失效前重新居中 */
+	static constexpr float OCCLUSION_CACHE_REFRESH_RADIUS = 50.0f;
+
+	/** 有效体积内异步刷新间隔 */
+	static constexpr float OCCLUSION_ASYNC_INTERVAL = 0.1f;
+
+	/** 遮挡系数平滑速度 */
+	static constexpr float OCCLUSION_SMOOTH_SPEED = 8.0f;
+
+	/** 完全遮挡时相机臂长度缩放 */
+	static constexpr float OCCLUDED_ARM_LENGTH_SCALE = 0.85f;
+
+	// ==================== 编译后的共享设置 ====================
+	/** 编译后的共享锁定设置 */
+	mutable TSharedPtr<const FCompiledLockOnSettings> CompiledSettings;
+
+	// ==================== 目标相机配置档句柄 ====================
+	/** 配置档句柄对应的目标（目标变化时才重新解析） */
+	mutable TWeakObjectPtr<AActor> ProfiledTarget;
+
+	/** 目标上的相机配置组件（持有已解析的配置档） */
+	mutable TWeakObjectPtr<const UEnemyCameraConfigComponent> ProfileSource;
+
+	/** 句柄是否来自配置组件（组件被销毁时重新解析） */
+	mutable bool bProfileFromComponent = false;
+
+	/** 没有配置组件的目标按包围盒解析一次的配置档 */
+	mutable FResolvedEnemyCameraProfile FallbackProfile;
+
+	// ==================== 地形高度缓存 ====================
+	/** 以玩家为中心的滚动地形高度网格（ApplyTerrainHeightCompensation为const查询，故为mutable） */
+	mutable FTerrainHeightCache TerrainHeightCache;
+
+	// ==================== 相机质量采样 ====================
+	/** 性能分析子系统（只在监控开启时采样） */
+	TWeakObjectPtr<UPerformanceProfiler> QualityProfiler;
+
+	/** 上一帧的控制旋转 */
+	FRotator LastMetricRotation = FRotator::ZeroRotator;
+
+	/** 上一帧的角速度与角加速度（用于计算角加加速度） */
+	float LastAngularVelocity = 0.0f;
+	float LastAngularAcceleration = 0.0f;
+
+	/** 连续采样帧数（角速度需要1帧历史，角加加速度需要3帧） */
+	int32 MetricHistoryFrames = 0;
+
+	/** SetLockOnTarget的时间，对准目标后记录耗时（<0表示不在等待对准） */
+	float LockOnAcquireStartTime = -1.0f;
+
+	/** 相机方向与目标方向的夹角小于该值视为已对准 */
+	static constexpr float ACQUIRE_ANGLE_THRESHOLD = 5.0f;
+
 	// ==================== FreeLook状态 ====================
 protected:
 	/** FreeLook状态 */
@@ -306,6 +426,9 @@ protected:
 	UPROPERTY()
 	AActor* LastFrameTarget = nullptr;
 
+	/** 正在由相机管理器执行延迟求解（此时UpdateLockOnCamera不跳过） */
+	bool bIsInLateLockOnSolve = false;
+
 	// ==================== 递归防护系统 ====================
 	/** 递归调用深度计数器 */
 	mutable int32 RecursionDepth;
@@ -384,6 +507,22 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Camera Control")
 	AActor* GetCurrentLockOnTarget() const { return CurrentLockOnTarget; }
 
+	/** 设置共享的编译后锁定设置（由拥有者统一构建并分发） */
+	void SetCompiledSettings(TSharedPtr<const FCompiledLockOnSettings> InCompiledSettings);
+
+	/** 获取编译后的锁定设置（尚未分发时根据本组件的配置构建一次） */
+	const FCompiledLockOnSettings& GetCompiledSettings() const;
+
+	/** 相机设置变更时触发（拥有者据此重建编译后的共享设置） */
+	FSimpleMulticastDelegate OnCameraSettingsChanged;
+
+	/** 获取目标的已解析相机配置档（按目标缓存句柄，目标不变时不重新分类） */
+	const FResolvedEnemyCameraProfile& GetTargetCameraProfile(AActor* Target) const;
+
+	/** 获取平滑后的相机遮挡系数（0=无遮挡，1=被遮挡） */
+	UFUNCTION(BlueprintCallable, Category = "Camera Control")
+	float GetSmoothedOcclusionFactor() const { return SmoothedOcclusionFactor; }
+
 	// ==================== 3D视口控制 ====================
 	
 	/** 3D控制设置 */
@@ -596,6 +735,24 @@ protected:
 	/** 按体型与距离微调相机臂长度 */
 	void AdjustSpringArmForSizeDistance(EEnemySizeCategory SizeCategory, float Distance, float BoundingHeight);
 
+	/** 拉取异步遮挡检测结果并平滑遮挡系数（每帧调用） */
+	void UpdateOcclusionCache(float DeltaTime);
+
+	/** 锁定期间查询遮挡并按平滑遮挡系数持续调整相机臂长度（每帧调用） */
+	void UpdateSpringArmOcclusion();
+
+	/** 采样相机质量指标（角速度、角加加速度、屏幕偏移、对准耗时） */
+	void UpdateCameraQualityMetrics(float DeltaTime);
+
+	/** 获取用于记录质量指标的分析器，监控关闭时返回nullptr */
+	UPerformanceProfiler* GetQualityProfiler() const;
+
+	/** 检查当前位置是否仍在遮挡缓存的有效体积（指定半径）内 */
+	bool IsOcclusionCacheValid(const FVector& CameraLocation, const FVector& SocketLocation, const FVector& PlayerLocation, float Radius = OCCLUSION_CACHE_RADIUS) const;
+
+	/** 在有效体积内按间隔发起异步遮挡检测（bImmediate时忽略间隔） */
+	void RequestAsyncOcclusionTrace(const FVector& CameraLocation, const FVector& SocketLocation, const FVector& PlayerLocation, bool bImmediate = false) const;
+
 private:
 	// ==================== 私有辅助函数 ====================
 	
@@ -1,6 +1,7 @@
 ﻿#include "CameraDebugComponent.h"
 #include "CameraControlComponent.h"
 #include "DrawDebugHelpers.h"
+#include "Components/LineBatchComponent.h"
 #include "Engine/Engine.h"
 #include "GameFramework/PlayerController.h"
 #include "Kismet/GameplayStatics.h"
@@ -34,8 +35,8 @@ static FAutoConsoleCommand CmdSetDebugMode(
 			{
 				if (It->GetWorld() && !It->GetWorld()->bIsTearingDown)
 				{
-					It->VisualizationMode = (EDebugVisualizationMode)FMath::Clamp(Mode, 0, 5);
-					It->bEnableDebugVisualization = (Mode > 0);
+					It->SetVisualizationMode((EDebugVisualizationMode)FMath::Clamp(Mode, 0, 5));
+					It->SetDebugVisualizationEnabled(Mode > 0);
 					UE_LOG(LogTemp, Warning, TEXT("Debug mode set to: %d"), Mode);
 				}
 			}
@@ -60,7 +61,9 @@ static FAutoConsoleCommand CmdClearDebugDraw(
 
 UCameraDebugComponent::UCameraDebugComponent()
 {
-    PrimaryComponentTick.bCanEverTick = true;
+    // 只在可视化开启时Tick（Shipping中绘制层被编译移除，组件永不Tick）
+    PrimaryComponentTick.bCanEverTick = ENABLE_DRAW_DEBUG != 0;
+    PrimaryComponentTick.bStartWithTickEnabled = false;
     
     // 默认设置
     bEnableDebugVisualization = false;
@@ -80,13 +83,31 @@ void UCameraDebugComponent::BeginPlay()
 {
     Super::BeginPlay();
     
+    UpdateDebugTickState();
+    
     UE_LOG(LogTemp, Log, TEXT("CameraDebugComponent initialized - Debug visualization for development only"));
 }
 
+void UCameraDebugComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+#if ENABLE_DRAW_DEBUG
+    // 清除本实例的持久边界盒批次，避免组件销毁后线条残留在世界中
+    UWorld* World = GetWorld();
+    if (World && World->PersistentLineBatcher)
+    {
+        World->PersistentLineBatcher->ClearBatch(GetTargetBoundsBatchId());
+    }
+    DrawBuffer.Reset();
+#endif
+    
+    Super::EndPlay(EndPlayReason);
+}
+
 void UCameraDebugComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
     Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
     
+#if ENABLE_DRAW_DEBUG
     // 性能统计
     if (bShowPerformanceStats)
     {
@@ -105,69 +126,71 @@ void UCameraDebugComponent::TickComponent(float DeltaTime, ELevelTick TickType,
         }
     }
     
-    if (!bEnableDebugVisualization || VisualizationMode == EDebugVisualizationMode::None)
-        return;
+    // 根据模式启用不同的Debug类别，各绘制函数只在类别启用时追加记录
+    DrawBuffer.SetEnabledCategories(GetEnabledDrawCategories());
     
     UCameraControlComponent* CameraControl = GetCameraControlComponent();
-    if (!CameraControl)
-        return;
+    AActor* CurrentTarget = CameraControl ? CameraControl->GetCurrentLockOnTarget() : nullptr;
     
-    AActor* CurrentTarget = CameraControl->GetCurrentLockOnTarget();
+    bIsBatchingFrame = true;
     
-    // 根据模式绘制不同的Debug信息
-    switch (VisualizationMode)
+    if (CurrentTarget && DrawBuffer.IsCategoryEnabled(EDebugDrawCategory::Target))
     {
-    case EDebugVisualizationMode::TargetInfo:
-        if (CurrentTarget)
-        {
-            DrawTargetBounds(CurrentTarget);
-        }
-        break;
-        
-    case EDebugVisualizationMode::CameraMetrics:
-        DrawCameraMetrics();
-        break;
-        
-    case EDebugVisualizationMode::LockOnTrace:
-        if (CurrentTarget && GetOwner())
-        {
-            DrawLockOnTrace(GetOwner()->GetActorLocation(), CurrentTarget->GetActorLocation());
-        }
-        break;
-        
-    case EDebugVisualizationMode::Performance:
-        DrawPerformanceStats();
-        break;
-        
-    case EDebugVisualizationMode::All:
-        if (CurrentTarget)
-        {
-            DrawTargetBounds(CurrentTarget);
-            if (GetOwner())
-            {
-                DrawLockOnTrace(GetOwner()->GetActorLocation(), CurrentTarget->GetActorLocation());
-            }
-        }
-        DrawCameraMetrics();
-        DrawPerformanceStats();
-        break;
+        DrawTargetBounds(CurrentTarget);
     }
+    else
+    {
+        DrawBuffer.RemovePersistent(GetTargetBoundsBatchId());
+    }
+    
+    if (CurrentTarget && GetOwner())
+    {
+        DrawLockOnTrace(GetOwner()->GetActorLocation(), CurrentTarget->GetActorLocation());
+    }
+    
+    DrawCameraMetrics();
+    DrawPerformanceStats();
+    
+    bIsBatchingFrame = false;
+    
+    // 每帧只提交一次
+    DrawBuffer.Flush(GetWorld(), DebugDrawDuration);
+#endif
 }
 
 void UCameraDebugComponent::DrawTargetBounds(AActor* Target)
 {
-    if (!Target)
+#if ENABLE_DRAW_DEBUG
+    if (!Target || !BeginDraw(EDebugDrawCategory::Target))
         return;
     
     // 获取目标边界
     FVector Origin, BoxExtent;
     Target->GetActorBounds(false, Origin, BoxExtent);
     
-    // 绘制边界盒
-    DrawDebugBox(GetWorld(), Origin, BoxExtent, DebugLineColor.ToFColor(true), false, DebugDrawDuration);
+    const FColor BoundsColor = DebugLineColor.ToFColor(true);
+    const FVector TargetLocation = Target->GetActorLocation();
+    FVector ForwardEnd = TargetLocation + Target->GetActorForwardVector() * 100.0f;
     
-    // 绘制中心点
-    DrawDebugSphere(GetWorld(), Target->GetActorLocation(), 20.0f, 12, FColor::Red, false, DebugDrawDuration);
+    // 边界盒、中心点和前向箭头作为持久图元，只在目标移动（按1单位量化）或颜色变化时重建
+    uint32 BoundsHash = GetTypeHash(Target);
+    BoundsHash = HashCombine(BoundsHash, GetTypeHash(FIntVector(Origin)));
+    BoundsHash = HashCombine(BoundsHash, GetTypeHash(FIntVector(BoxExtent)));
+    BoundsHash = HashCombine(BoundsHash, GetTypeHash(FIntVector(TargetLocation)));
+    BoundsHash = HashCombine(BoundsHash, GetTypeHash(FIntVector(ForwardEnd)));
+    BoundsHash = HashCombine(BoundsHash, GetTypeHash(BoundsColor));
+    
+    if (DrawBuffer.UpdatePersistent(GetTargetBoundsBatchId(), BoundsHash))
+    {
+        // 绘制边界盒
+        DrawBuffer.AddBox(EDebugDrawCategory::Target, Origin, BoxExtent, BoundsColor, 0.0f, GetTargetBoundsBatchId());
+        
+        // 绘制中心点
+        DrawBuffer.AddSphere(EDebugDrawCategory::Target, TargetLocation, 20.0f, 12, FColor::Red, 0.0f, GetTargetBoundsBatchId());
+        
+        // 绘制目标的前向方向
+        DrawBuffer.AddArrow(EDebugDrawCategory::Target, TargetLocation, ForwardEnd, 50.0f, FColor::Blue, 2.0f, GetTargetBoundsBatchId());
+    }
     
     // 绘制目标信息（仅调试文本，不是UMG）
     if (bShowCameraParameters)
@@ -178,16 +201,18 @@ void UCameraDebugComponent::DrawTargetBounds(AActor* Target)
         Draw3DDebugString(Origin + FVector(0, 0, BoxExtent.Z + 50), InfoText, FColor::White);
     }
     
-    // 绘制目标的前向方向
-    FVector ForwardEnd = Target->GetActorLocation() + Target->GetActorForwardVector() * 100.0f;
-    DrawDebugDirectionalArrow(GetWorld(), Target->GetActorLocation(), ForwardEnd, 
-        50.0f, FColor::Blue, false, DebugDrawDuration, 0, 2.0f);
+    EndDraw();
+#endif
 }
 
 void UCameraDebugComponent::DrawLockOnTrace(const FVector& CameraLocation, const FVector& TargetLocation)
 {
+#if ENABLE_DRAW_DEBUG
+    if (!BeginDraw(EDebugDrawCategory::LockOnTrace))
+        return;
+    
     // 绘制锁定追踪线
-    DrawDebugLine(GetWorld(), CameraLocation, TargetLocation, FColor::Green, false, DebugDrawDuration, 0, 2.0f);
+    DrawBuffer.AddLine(EDebugDrawCategory::LockOnTrace, CameraLocation, TargetLocation, FColor::Green, 2.0f);
     
     // 计算和显示距离
     float Distance = FVector::Dist(CameraLocation, TargetLocation);
@@ -197,11 +222,18 @@ void UCameraDebugComponent::DrawLockOnTrace(const FVector& CameraLocation, const
     Draw3DDebugString(MidPoint, DistanceText, FColor::Green);
     
     // 绘制中点标记
-    DrawDebugSphere(GetWorld(), MidPoint, 10.0f, 8, FColor::Yellow, false, DebugDrawDuration);
+    DrawBuffer.AddSphere(EDebugDrawCategory::LockOnTrace, MidPoint, 10.0f, 8, FColor::Yellow);
+    
+    EndDraw();
+#endif
 }
 
 void UCameraDebugComponent::DrawCameraMetrics()
 {
+#if ENABLE_DRAW_DEBUG
+    if (!BeginDraw(EDebugDrawCategory::Metrics))
+        return;
+    
     UCameraControlComponent* CameraControl = GetCameraControlComponent();
     if (!CameraControl || !GetOwner())
         return;
@@ -228,11 +260,15 @@ void UCameraDebugComponent::DrawCameraMetrics()
     
     // 在玩家上方显示
     Draw3DDebugString(OwnerLocation + FVector(0, 0, 200), MetricsText, FColor::Cyan);
+    
+    EndDraw();
+#endif
 }
 
 void UCameraDebugComponent::DrawPerformanceStats()
 {
-    if (!bShowPerformanceStats || !GetOwner())
+#if ENABLE_DRAW_DEBUG
+    if (!bShowPerformanceStats || !GetOwner() || !BeginDraw(EDebugDrawCategory::Performance))
         return;
     
     FVector OwnerLocation = GetOwner()->GetActorLocation();
@@ -253,10 +289,16 @@ void UCameraDebugComponent::DrawPerformanceStats()
     
     // 在玩家左侧显示
     Draw3DDebugString(OwnerLocation + FVector(-150, 0, 100), PerfText, FColor::Orange);
+    
+    EndDraw();
+#endif
 }
 
 void UCameraDebugComponent::ClearAllDebugDrawing()
 {
+#if ENABLE_DRAW_DEBUG
+    DrawBuffer.Reset();
+#endif
     FlushDebugStrings(GetWorld());
     FlushPersistentDebugLines(GetWorld());
     
@@ -267,15 +309,75 @@ void UCameraDebugComponent::ToggleDebugMode()
 {
     bEnableDebugVisualization = !bEnableDebugVisualization;
     
-    if (!bEnableDebugVisualization)
+    UpdateDebugTickState();
+    
+    UE_LOG(LogTemp, Warning, TEXT("Camera Debug Visualization: %s"), 
+        bEnableDebugVisualization ? TEXT("Enabled") : TEXT("Disabled"));
+}
+
+#if ENABLE_DRAW_DEBUG
+uint32 UCameraDebugComponent::GetTargetBoundsBatchId() const
+{
+    // 0表示单帧图元，不能作为持久批次ID
+    const uint32 BatchId = HashCombine(FCrc::StrCrc32(TEXT("CameraDebugTargetBounds")), GetUniqueID());
+    return BatchId != 0 ? BatchId : 1;
+}
+#endif
+
+void UCameraDebugComponent::UpdateDebugTickState()
+{
+#if ENABLE_DRAW_DEBUG
+    const bool bWantsTick = (bEnableDebugVisualization && VisualizationMode != EDebugVisualizationMode::None) || bShowPerformanceStats;
+    
+    // 关闭可视化时清除已绘制的持久图元
+    if (!bWantsTick && IsComponentTickEnabled())
     {
         ClearAllDebugDrawing();
     }
     
-    UE_LOG(LogTemp, Warning, TEXT("Camera Debug Visualization: %s"), 
-        bEnableDebugVisualization ? TEXT("Enabled") : TEXT("Disabled"));
+    SetComponentTickEnabled(bWantsTick);
+#endif
+}
+
+void UCameraDebugComponent::SetDebugVisualizationEnabled(bool bEnabled)
+{
+    bEnableDebugVisualization = bEnabled;
+    UpdateDebugTickState();
+}
+
+void UCameraDebugComponent::SetVisualizationMode(EDebugVisualizationMode NewMode)
+{
+    VisualizationMode = NewMode;
+    UpdateDebugTickState();
 }
 
+void UCameraDebugComponent::SetShowPerformanceStats(bool bShow)
+{
+    bShowPerformanceStats = bShow;
+    UpdateDebugTickState();
+}
+
+#if WITH_EDITOR
+void UCameraDebugComponent::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+    
+    if (!PropertyChangedEvent.Property || !HasBegunPlay())
+    {
+        return;
+    }
+    
+    // 运行中（PIE）在细节面板修改可视化设置时同步Tick状态
+    const FName PropertyName = PropertyChangedEvent.Property->GetFName();
+    if (PropertyName == GET_MEMBER_NAME_CHECKED(UCameraDebugComponent, bEnableDebugVisualization)
+        || PropertyName == GET_MEMBER_NAME_CHECKED(UCameraDebugComponent, VisualizationMode)
+        || PropertyName == GET_MEMBER_NAME_CHECKED(UCameraDebugComponent, bShowPerformanceStats))
+    {
+        UpdateDebugTickState();
+    }
+}
+#endif
+
 void UCameraDebugComponent::DumpCameraStateToLog()
 {
     UCameraControlComponent* CameraControl = GetCameraControlComponent();
@@ -309,5 +411,49 @@ UCameraControlComponent* UCameraDebugComponent::GetCameraControlComponent() cons
 
 void UCameraDebugComponent::Draw3DDebugString(const FVector& Location, const FString& Text, const FColor& Color)
 {
-    DrawDebugString(GetWorld(), Location, Text, nullptr, Color, DebugDrawDuration, false);
+#if ENABLE_DRAW_DEBUG
+    // 文本随调用它的绘制函数归入同一类别，Tick外调用时所有类别均已启用
+    DrawBuffer.AddString(EDebugDrawCategory::All, Location, Text, Color);
+#endif
+}
+
+#if ENABLE_DRAW_DEBUG
+bool UCameraDebugComponent::BeginDraw(EDebugDrawCategory Category)
+{
+    if (!bIsBatchingFrame)
+    {
+        DrawBuffer.SetEnabledCategories(EDebugDrawCategory::All);
+    }
+    return DrawBuffer.IsCategoryEnabled(Category);
+}
+
+void UCameraDebugComponent::EndDraw()
+{
+    if (!bIsBatchingFrame)
+    {
+        DrawBuffer.Flush(GetWorld(), DebugDrawDuration);
+    }
+}
+
+EDebugDrawCategory UCameraDebugComponent::GetEnabledDrawCategories() const
+{
+    if (!bEnableDebugVisualization)
+        return EDebugDrawCategory::None;
+    
+    switch (VisualizationMode)
+    {
+    case EDebugVisualizationMode::TargetInfo:
+        return EDebugDrawCategory::Target;
+    case EDebugVisualizationMode::CameraMetrics:
+        return EDebugDrawCategory::Metrics;
+    case EDebugVisualizationMode::LockOnTrace:
+        return EDebugDrawCategory::LockOnTrace;
+    case EDebugVisualizationMode::Performance:
+        return EDebugDrawCategory::Performance;
+    case EDebugVisualizationMode::All:
+        return EDebugDrawCategory::All;
+    default:
+        return EDebugDrawCategory::None;
+    }
 }
+#endif
@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "DebugDrawBuffer.h"
 #include "CameraDebugComponent.generated.h"
 
 /** Debug可视化模式 */
@@ -30,16 +31,17 @@ public:
 
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
 public:
     // ==================== Debug设置 ====================
-    /** 启用Debug可视化 */
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Settings")
+    /** 启用Debug可视化（运行时通过SetDebugVisualizationEnabled修改） */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Debug Settings")
     bool bEnableDebugVisualization;
     
-    /** 可视化模式 */
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Settings")
+    /** 可视化模式（运行时通过SetVisualizationMode修改） */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Debug Settings")
     EDebugVisualizationMode VisualizationMode;
     
     /** Debug线条颜色 */
@@ -50,8 +52,8 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Settings", meta = (ClampMin = "0.0", ClampMax = "10.0"))
     float DebugDrawDuration;
     
-    /** 显示性能统计 */
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Settings")
+    /** 显示性能统计（运行时通过SetShowPerformanceStats修改） */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Debug Settings")
     bool bShowPerformanceStats;
     
     /** 显示相机参数 */
@@ -83,10 +85,31 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Debug", meta = (CallInEditor = "true"))
     void ToggleDebugMode();
     
+    /** 根据当前设置开启或关闭Tick（运行时修改可视化设置后调用，关闭时组件不再Tick） */
+    UFUNCTION(BlueprintCallable, Category = "Debug")
+    void UpdateDebugTickState();
+    
+    /** 开启或关闭Debug可视化 */
+    UFUNCTION(BlueprintCallable, Category = "Debug")
+    void SetDebugVisualizationEnabled(bool bEnabled);
+    
+    /** 设置可视化模式 */
+    UFUNCTION(BlueprintCallable, Category = "Debug")
+    void SetVisualizationMode(EDebugVisualizationMode NewMode);
+    
+    /** 开启或关闭性能统计 */
+    UFUNCTION(BlueprintCallable, Category = "Debug")
+    void SetShowPerformanceStats(bool bShow);
+    
     /** 输出当前相机状态到日志 */
     UFUNCTION(BlueprintCallable, Category = "Debug", meta = (CallInEditor = "true"))
     void DumpCameraStateToLog();
 
+#if WITH_EDITOR
+    /** 编辑器中修改可视化设置后刷新Tick状态 */
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
 private:
     /** 获取相机控制组件 */
     class UCameraControlComponent* GetCameraControlComponent() const;
@@ -98,4 +121,24 @@ private:
     
     /** 绘制3D文本 */
     void Draw3DDebugString(const FVector& Location, const FString& Text, const FColor& Color);
+    
+#if ENABLE_DRAW_DEBUG
+    /** 开始一次绘制：Tick外的直接调用视为显式请求，启用所有类别 */
+    bool BeginDraw(EDebugDrawCategory Category);
+    
+    /** 结束一次绘制：Tick外的直接调用立即提交，Tick内由Tick统一提交 */
+    void EndDraw();
+    
+    /** 根据可视化模式计算启用的类别 */
+    EDebugDrawCategory GetEnabledDrawCategories() const;
+    
+    /** 调试绘制命令缓冲 */
+    FDebugDrawBuffer DrawBuffer;
+    
+    /** 是否处于Tick的批量绘制中 */
+    bool bIsBatchingFrame = false;
+    
+    /** 目标边界盒与朝向箭头的持久批次（按实例区分，避免多个组件共用世界的持久批处理器时互相清除） */
+    uint32 GetTargetBoundsBatchId() const;
+#endif
 };
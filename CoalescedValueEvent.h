@@ -0,0 +1,67 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 数值变化事件的合并与量化
+ * 连续变化（例如每帧恢复）只标记为待发布，由拥有者在Tick末尾Flush，因此每帧最多发布一次，
+ * 且只有数值跨过量化步长的边界时才真正发布；到达0或上限等离散状态总是立即发布。
+ */
+struct SOUL_API FCoalescedValueEvent
+{
+public:
+	/**
+	 * 记录一次数值变化
+	 * @param bForce 离散状态变化（耗尽、破防、重置等），要求立即发布
+	 * @return 需要立即发布时返回true，否则留待Flush
+	 */
+	bool MarkChanged(float Value, float MaxValue, bool bForce)
+	{
+		bPending = true;
+		return bForce || !bHasPublished || (IsBoundary(Value, MaxValue) && Value != LastPublishedValue);
+	}
+
+	/**
+	 * 取出本帧待发布的变化（Tick末尾调用）
+	 * @param QuantizationStep 量化步长（小于等于0时任何变化都发布）
+	 * @return 需要发布时返回true
+	 */
+	bool ConsumePending(float Value, float QuantizationStep)
+	{
+		if (!bPending)
+			return false;
+
+		bPending = false;
+		if (QuantizationStep <= 0.0f)
+			return Value != LastPublishedValue;
+
+		return FMath::FloorToInt(Value / QuantizationStep) != FMath::FloorToInt(LastPublishedValue / QuantizationStep);
+	}
+
+	/** 记录已发布的数值 */
+	void MarkPublished(float Value)
+	{
+		LastPublishedValue = Value;
+		bHasPublished = true;
+		bPending = false;
+	}
+
+	void Reset()
+	{
+		LastPublishedValue = 0.0f;
+		bHasPublished = false;
+		bPending = false;
+	}
+
+private:
+	static bool IsBoundary(float Value, float MaxValue)
+	{
+		return Value <= 0.0f || Value >= MaxValue;
+	}
+
+	float LastPublishedValue = 0.0f;
+	bool bHasPublished = false;
+	bool bPending = false;
+};
@@ -0,0 +1,182 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CombatStatsSubsystem.h"
+#include "StaminaComponent.h"
+#include "PoiseComponent.h"
+#include "Engine/World.h"
+
+// ==================== FCombatStatBuffer ====================
+
+int32 FCombatStatBuffer::Allocate()
+{
+	if (FreeSlots.Num() > 0)
+	{
+		return FreeSlots.Pop();
+	}
+
+	Values.Add(0.0f);
+	MaxValues.Add(0.0f);
+	RecoveryRates.Add(0.0f);
+	RecoveryResumeTimes.Add(0.0f);
+	return DirtyFlags.Add(0);
+}
+
+void FCombatStatBuffer::Release(int32 Slot)
+{
+	if (!Values.IsValidIndex(Slot))
+		return;
+
+	RecoveryRates[Slot] = 0.0f;
+	DirtyFlags[Slot] = 0;
+	FreeSlots.Add(Slot);
+}
+
+void FCombatStatBuffer::Update(int32 Slot, float Value, float MaxValue, float RecoveryRate, float RecoveryResumeTime)
+{
+	if (!Values.IsValidIndex(Slot))
+		return;
+
+	Values[Slot] = Value;
+	MaxValues[Slot] = MaxValue;
+	RecoveryRates[Slot] = RecoveryRate;
+	RecoveryResumeTimes[Slot] = RecoveryResumeTime;
+}
+
+void FCombatStatBuffer::Integrate(float CurrentTime, float DeltaTime)
+{
+	const int32 Count = Values.Num();
+	float* RESTRICT ValueData = Values.GetData();
+	const float* RESTRICT MaxData = MaxValues.GetData();
+	const float* RESTRICT RateData = RecoveryRates.GetData();
+	const float* RESTRICT ResumeData = RecoveryResumeTimes.GetData();
+	uint8* RESTRICT DirtyData = DirtyFlags.GetData();
+
+	// 无分支的恢复积分：未到恢复时间或速率为0的槽位增量为0
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		const float Rate = CurrentTime >= ResumeData[Index] ? RateData[Index] : 0.0f;
+		const float OldValue = ValueData[Index];
+		const float NewValue = FMath::Min(OldValue + Rate * DeltaTime, FMath::Max(OldValue, MaxData[Index]));
+		ValueData[Index] = NewValue;
+		DirtyData[Index] |= (uint8)(NewValue != OldValue);
+	}
+}
+
+void FCombatStatBuffer::ConsumeDirty(TArray<int32>& OutSlots)
+{
+	OutSlots.Reset();
+	for (int32 Index = 0; Index < DirtyFlags.Num(); ++Index)
+	{
+		if (DirtyFlags[Index])
+		{
+			DirtyFlags[Index] = 0;
+			OutSlots.Add(Index);
+		}
+	}
+}
+
+// ==================== UCombatStatsSubsystem ====================
+
+int32 UCombatStatsSubsystem::RegisterStamina(UStaminaComponent* Component)
+{
+	if (!Component)
+		return INDEX_NONE;
+
+	const int32 Slot = StaminaBuffer.Allocate();
+	if (StaminaOwners.Num() <= Slot)
+	{
+		StaminaOwners.SetNum(Slot + 1);
+	}
+	StaminaOwners[Slot] = Component;
+	return Slot;
+}
+
+void UCombatStatsSubsystem::UnregisterStamina(int32 Slot)
+{
+	if (!StaminaOwners.IsValidIndex(Slot))
+		return;
+
+	StaminaOwners[Slot].Reset();
+	StaminaBuffer.Release(Slot);
+}
+
+int32 UCombatStatsSubsystem::RegisterPoise(UPoiseComponent* Component)
+{
+	if (!Component)
+		return INDEX_NONE;
+
+	const int32 Slot = PoiseBuffer.Allocate();
+	if (PoiseOwners.Num() <= Slot)
+	{
+		PoiseOwners.SetNum(Slot + 1);
+	}
+	PoiseOwners[Slot] = Component;
+	return Slot;
+}
+
+void UCombatStatsSubsystem::UnregisterPoise(int32 Slot)
+{
+	if (!PoiseOwners.IsValidIndex(Slot))
+		return;
+
+	PoiseOwners[Slot].Reset();
+	PoiseBuffer.Release(Slot);
+}
+
+void UCombatStatsSubsystem::UpdateStamina(int32 Slot, float Value, float MaxValue, float RecoveryRate, float RecoveryResumeTime)
+{
+	StaminaBuffer.Update(Slot, Value, MaxValue, RecoveryRate, RecoveryResumeTime);
+}
+
+void UCombatStatsSubsystem::UpdatePoise(int32 Slot, float Value, float MaxValue, float RecoveryRate, float RecoveryResumeTime)
+{
+	PoiseBuffer.Update(Slot, Value, MaxValue, RecoveryRate, RecoveryResumeTime);
+}
+
+void UCombatStatsSubsystem::Deinitialize()
+{
+	StaminaOwners.Empty();
+	PoiseOwners.Empty();
+
+	Super::Deinitialize();
+}
+
+void UCombatStatsSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+
+	// 精力：一次积分全部槽位，只回调变化的组件
+	// 回调中可能注册/注销组件，按索引访问且每次重新取数组元素
+	StaminaBuffer.Integrate(CurrentTime, DeltaTime);
+	StaminaBuffer.ConsumeDirty(DirtyScratch);
+	for (int32 Slot : DirtyScratch)
+	{
+		if (UStaminaComponent* Component = StaminaOwners[Slot].Get())
+		{
+			Component->ApplyCombatStats(StaminaBuffer.GetValue(Slot));
+		}
+	}
+
+	// 韧性
+	PoiseBuffer.Integrate(CurrentTime, DeltaTime);
+	PoiseBuffer.ConsumeDirty(DirtyScratch);
+	for (int32 Slot : DirtyScratch)
+	{
+		if (UPoiseComponent* Component = PoiseOwners[Slot].Get())
+		{
+			Component->ApplyCombatStats(PoiseBuffer.GetValue(Slot));
+		}
+	}
+}
+
+TStatId UCombatStatsSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatStatsSubsystem, STATGROUP_Tickables);
+}
+
+bool UCombatStatsSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
@@ -0,0 +1,101 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatStatsSubsystem.generated.h"
+
+class UStaminaComponent;
+class UPoiseComponent;
+
+/**
+ * 一类战斗数值的结构数组缓冲
+ * 每个槽位对应一个注册的组件，恢复积分只读写连续的浮点数组，便于编译器向量化。
+ * 注销的槽位只清零速率并放入空闲列表，不做搬移，已发出的槽位索引始终有效。
+ */
+struct SOUL_API FCombatStatBuffer
+{
+public:
+	/** 分配一个槽位 */
+	int32 Allocate();
+
+	/** 释放槽位（速率清零，留待复用） */
+	void Release(int32 Slot);
+
+	/** 由组件推送当前数值与恢复参数 */
+	void Update(int32 Slot, float Value, float MaxValue, float RecoveryRate, float RecoveryResumeTime);
+
+	/** 标记槽位需要回调组件（例如有待发布的事件） */
+	void MarkDirty(int32 Slot) { if (DirtyFlags.IsValidIndex(Slot)) DirtyFlags[Slot] = 1; }
+
+	/** 对所有槽位做一次恢复积分，数值变化的槽位被标记为脏 */
+	void Integrate(float CurrentTime, float DeltaTime);
+
+	/** 取出并清除脏槽位 */
+	void ConsumeDirty(TArray<int32>& OutSlots);
+
+	float GetValue(int32 Slot) const { return Values[Slot]; }
+	int32 Num() const { return Values.Num(); }
+	int32 NumActive() const { return Values.Num() - FreeSlots.Num(); }
+
+private:
+	TArray<float> Values;
+	TArray<float> MaxValues;
+	TArray<float> RecoveryRates;
+	TArray<float> RecoveryResumeTimes;
+	TArray<uint8> DirtyFlags;
+
+	TArray<int32> FreeSlots;
+};
+
+/**
+ * 战斗数值子系统
+ * 集中保存所有注册角色的精力与韧性恢复状态（结构数组），每帧用一个循环完成全部恢复积分，
+ * 只回调数值真正变化或有待发布事件的组件；注册后组件自身不再Tick。
+ * 组件仍保留当前值的镜像与全部接口，消耗/受击等离散操作照常在组件上执行并把结果推送回来，
+ * 基于组件的玩法代码无需修改。
+ */
+UCLASS()
+class SOUL_API UCombatStatsSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** 注册/注销精力组件，返回槽位 */
+	int32 RegisterStamina(UStaminaComponent* Component);
+	void UnregisterStamina(int32 Slot);
+
+	/** 注册/注销韧性组件，返回槽位 */
+	int32 RegisterPoise(UPoiseComponent* Component);
+	void UnregisterPoise(int32 Slot);
+
+	/** 组件推送数值与恢复参数（速率为0表示当前不恢复） */
+	void UpdateStamina(int32 Slot, float Value, float MaxValue, float RecoveryRate, float RecoveryResumeTime);
+	void UpdatePoise(int32 Slot, float Value, float MaxValue, float RecoveryRate, float RecoveryResumeTime);
+
+	/** 请求在下一次更新时回调组件 */
+	void MarkStaminaDirty(int32 Slot) { StaminaBuffer.MarkDirty(Slot); }
+	void MarkPoiseDirty(int32 Slot) { PoiseBuffer.MarkDirty(Slot); }
+
+	int32 GetNumStamina() const { return StaminaBuffer.NumActive(); }
+	int32 GetNumPoise() const { return PoiseBuffer.NumActive(); }
+
+	// UTickableWorldSubsystem
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	FCombatStatBuffer StaminaBuffer;
+	FCombatStatBuffer PoiseBuffer;
+
+	TArray<TWeakObjectPtr<UStaminaComponent>> StaminaOwners;
+	TArray<TWeakObjectPtr<UPoiseComponent>> PoiseOwners;
+
+	/** 本帧需要回调的槽位（复用） */
+	TArray<int32> DirtyScratch;
+};
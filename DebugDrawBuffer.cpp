@@ -0,0 +1,195 @@
+﻿#include "DebugDrawBuffer.h"
+
+#if ENABLE_DRAW_DEBUG
+
+#include "DrawDebugHelpers.h"
+#include "Components/LineBatchComponent.h"
+#include "Engine/World.h"
+
+void FDebugDrawBuffer::AddLine(EDebugDrawCategory Category, const FVector& Start, const FVector& End, const FColor& Color, float Thickness, uint32 BatchId)
+{
+	if (!IsCategoryEnabled(Category))
+		return;
+
+	AddLineRecord(Start, End, Color, Thickness, BatchId);
+}
+
+void FDebugDrawBuffer::AddBox(EDebugDrawCategory Category, const FVector& Center, const FVector& Extent, const FColor& Color, float Thickness, uint32 BatchId)
+{
+	if (!IsCategoryEnabled(Category))
+		return;
+
+	// 12条棱
+	const FVector Corners[8] =
+	{
+		Center + FVector( Extent.X,  Extent.Y,  Extent.Z),
+		Center + FVector( Extent.X, -Extent.Y,  Extent.Z),
+		Center + FVector(-Extent.X, -Extent.Y,  Extent.Z),
+		Center + FVector(-Extent.X,  Extent.Y,  Extent.Z),
+		Center + FVector( Extent.X,  Extent.Y, -Extent.Z),
+		Center + FVector( Extent.X, -Extent.Y, -Extent.Z),
+		Center + FVector(-Extent.X, -Extent.Y, -Extent.Z),
+		Center + FVector(-Extent.X,  Extent.Y, -Extent.Z)
+	};
+
+	for (int32 Index = 0; Index < 4; ++Index)
+	{
+		const int32 Next = (Index + 1) % 4;
+		AddLineRecord(Corners[Index], Corners[Next], Color, Thickness, BatchId);
+		AddLineRecord(Corners[Index + 4], Corners[Next + 4], Color, Thickness, BatchId);
+		AddLineRecord(Corners[Index], Corners[Index + 4], Color, Thickness, BatchId);
+	}
+}
+
+void FDebugDrawBuffer::AddSphere(EDebugDrawCategory Category, const FVector& Center, float Radius, int32 Segments, const FColor& Color, float Thickness, uint32 BatchId)
+{
+	if (!IsCategoryEnabled(Category))
+		return;
+
+	// 三个正交大圆
+	Segments = FMath::Max(Segments, 4);
+	const float AngleStep = 2.0f * PI / Segments;
+	for (int32 Index = 0; Index < Segments; ++Index)
+	{
+		float SinA, CosA, SinB, CosB;
+		FMath::SinCos(&SinA, &CosA, AngleStep * Index);
+		FMath::SinCos(&SinB, &CosB, AngleStep * (Index + 1));
+
+		AddLineRecord(Center + FVector(CosA, SinA, 0.0f) * Radius, Center + FVector(CosB, SinB, 0.0f) * Radius, Color, Thickness, BatchId);
+		AddLineRecord(Center + FVector(CosA, 0.0f, SinA) * Radius, Center + FVector(CosB, 0.0f, SinB) * Radius, Color, Thickness, BatchId);
+		AddLineRecord(Center + FVector(0.0f, CosA, SinA) * Radius, Center + FVector(0.0f, CosB, SinB) * Radius, Color, Thickness, BatchId);
+	}
+}
+
+void FDebugDrawBuffer::AddArrow(EDebugDrawCategory Category, const FVector& Start, const FVector& End, float ArrowSize, const FColor& Color, float Thickness, uint32 BatchId)
+{
+	if (!IsCategoryEnabled(Category))
+		return;
+
+	AddLineRecord(Start, End, Color, Thickness, BatchId);
+
+	// 箭头两翼（与DrawDebugDirectionalArrow相同的构造方式）
+	FVector Dir = End - Start;
+	if (!Dir.Normalize())
+		return;
+
+	FVector Up(0.0f, 0.0f, 1.0f);
+	FVector Right = Dir ^ Up;
+	if (!Right.IsNormalized())
+	{
+		Dir.FindBestAxisVectors(Up, Right);
+	}
+
+	const FMatrix TM(Dir, Right, Up, FVector::ZeroVector);
+	const float ArrowSqrt = FMath::Sqrt(ArrowSize);
+	AddLineRecord(End, End + TM.TransformPosition(FVector(-ArrowSqrt, ArrowSqrt, 0.0f)), Color, Thickness, BatchId);
+	AddLineRecord(End, End + TM.TransformPosition(FVector(-ArrowSqrt, -ArrowSqrt, 0.0f)), Color, Thickness, BatchId);
+}
+
+void FDebugDrawBuffer::AddString(EDebugDrawCategory Category, const FVector& Location, const FString& Text, const FColor& Color)
+{
+	if (!IsCategoryEnabled(Category))
+		return;
+
+	Strings.Add({ Location, Text, Color });
+}
+
+bool FDebugDrawBuffer::UpdatePersistent(uint32 BatchId, uint32 DataHash)
+{
+	uint32* ExistingHash = PersistentHashes.Find(BatchId);
+	if (ExistingHash && *ExistingHash == DataHash)
+		return false;
+
+	PersistentHashes.Add(BatchId, DataHash);
+	DirtyBatches.AddUnique(BatchId);
+	return true;
+}
+
+void FDebugDrawBuffer::RemovePersistent(uint32 BatchId)
+{
+	if (PersistentHashes.Remove(BatchId) > 0)
+	{
+		DirtyBatches.AddUnique(BatchId);
+	}
+}
+
+void FDebugDrawBuffer::Flush(UWorld* World, float LifeTime)
+{
+	if (!World)
+	{
+		TransientLines.Reset();
+		PersistentLines.Reset();
+		Strings.Reset();
+		return;
+	}
+
+	// 单帧图元：一次性提交（有持续时间时进入持久批处理器，按寿命自动移除）
+	ULineBatchComponent* TransientBatcher = LifeTime > 0.0f ? World->PersistentLineBatcher : World->LineBatcher;
+	if (TransientLines.Num() > 0 && TransientBatcher)
+	{
+		ScratchLines.Reset(TransientLines.Num());
+		for (const FLineRecord& Line : TransientLines)
+		{
+			ScratchLines.Emplace(FVector(Line.Start), FVector(Line.End), FLinearColor(Line.Color), LifeTime, Line.Thickness, SDPG_World);
+		}
+		TransientBatcher->DrawLines(ScratchLines);
+	}
+
+	// 持久图元：只重建数据变化的批次
+	if (DirtyBatches.Num() > 0 && World->PersistentLineBatcher)
+	{
+		for (uint32 BatchId : DirtyBatches)
+		{
+			World->PersistentLineBatcher->ClearBatch(BatchId);
+		}
+
+		ScratchLines.Reset(PersistentLines.Num());
+		for (const FLineRecord& Line : PersistentLines)
+		{
+			ScratchLines.Emplace(FVector(Line.Start), FVector(Line.End), FLinearColor(Line.Color), -1.0f, Line.Thickness, SDPG_World, Line.BatchId);
+		}
+		World->PersistentLineBatcher->DrawLines(ScratchLines);
+	}
+
+	// 调试文本没有批量接口，逐条提交
+	for (const FStringRecord& String : Strings)
+	{
+		DrawDebugString(World, String.Location, String.Text, nullptr, String.Color, LifeTime, false);
+	}
+
+	TransientLines.Reset();
+	PersistentLines.Reset();
+	Strings.Reset();
+	DirtyBatches.Reset();
+}
+
+void FDebugDrawBuffer::Reset()
+{
+	TransientLines.Reset();
+	PersistentLines.Reset();
+	Strings.Reset();
+	PersistentHashes.Reset();
+	DirtyBatches.Reset();
+}
+
+void FDebugDrawBuffer::AddLineRecord(const FVector& Start, const FVector& End, const FColor& Color, float Thickness, uint32 BatchId)
+{
+	FLineRecord Record;
+	Record.Start = FVector3f(Start);
+	Record.End = FVector3f(End);
+	Record.Color = Color;
+	Record.Thickness = Thickness;
+	Record.BatchId = BatchId;
+
+	if (BatchId == 0)
+	{
+		TransientLines.Add(Record);
+	}
+	else if (DirtyBatches.Contains(BatchId))
+	{
+		// 只接收本帧需要重建的批次
+		PersistentLines.Add(Record);
+	}
+}
+
+#endif // ENABLE_DRAW_DEBUG
@@ -0,0 +1,100 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "EngineDefines.h"
+
+#if ENABLE_DRAW_DEBUG
+
+#include "Components/LineBatchComponent.h"
+
+class UWorld;
+
+/** 调试绘制类别（按位启用） */
+enum class EDebugDrawCategory : uint8
+{
+	None		= 0,
+	Target		= 1 << 0,
+	LockOnTrace	= 1 << 1,
+	Metrics		= 1 << 2,
+	Performance	= 1 << 3,
+	All			= Target | LockOnTrace | Metrics | Performance
+};
+ENUM_CLASS_FLAGS(EDebugDrawCategory);
+
+/**
+ * 调试绘制命令缓冲
+ * 各调用方只在类别启用时追加紧凑的绘制记录，每帧Flush一次以单个批次提交给世界的线条批处理器。
+ * 持久图元按批次ID管理，只有数据哈希变化时才重建该批次。
+ * 整个缓冲在ENABLE_DRAW_DEBUG关闭时（Shipping）不参与编译。
+ */
+struct SOUL_API FDebugDrawBuffer
+{
+public:
+	/** 设置启用的类别 */
+	void SetEnabledCategories(EDebugDrawCategory InCategories) { EnabledCategories = InCategories; }
+
+	/** 类别是否启用（调用方应在构建绘制数据前先检查） */
+	bool IsCategoryEnabled(EDebugDrawCategory Category) const { return EnumHasAnyFlags(EnabledCategories, Category); }
+
+	/** 追加图元（BatchId为0表示单帧图元，否则加入对应的持久批次） */
+	void AddLine(EDebugDrawCategory Category, const FVector& Start, const FVector& End, const FColor& Color, float Thickness = 0.0f, uint32 BatchId = 0);
+	void AddBox(EDebugDrawCategory Category, const FVector& Center, const FVector& Extent, const FColor& Color, float Thickness = 0.0f, uint32 BatchId = 0);
+	void AddSphere(EDebugDrawCategory Category, const FVector& Center, float Radius, int32 Segments, const FColor& Color, float Thickness = 0.0f, uint32 BatchId = 0);
+	void AddArrow(EDebugDrawCategory Category, const FVector& Start, const FVector& End, float ArrowSize, const FColor& Color, float Thickness = 0.0f, uint32 BatchId = 0);
+	void AddString(EDebugDrawCategory Category, const FVector& Location, const FString& Text, const FColor& Color);
+
+	/**
+	 * 检查持久批次的数据是否变化
+	 * @return 变化时返回true，调用方随后追加该批次的图元；未变化时已绘制的图元保持不动
+	 */
+	bool UpdatePersistent(uint32 BatchId, uint32 DataHash);
+
+	/** 移除一个持久批次（下次Flush时清除其图元） */
+	void RemovePersistent(uint32 BatchId);
+
+	/** 提交本帧的所有记录（LifeTime大于0时单帧图元保留对应时长） */
+	void Flush(UWorld* World, float LifeTime);
+
+	/** 丢弃所有记录与持久批次状态（调用方负责清除已绘制的图元） */
+	void Reset();
+
+	/** 当前待提交的线段数 */
+	int32 GetNumPendingLines() const { return TransientLines.Num() + PersistentLines.Num(); }
+
+private:
+	/** 紧凑的线段记录 */
+	struct FLineRecord
+	{
+		FVector3f Start;
+		FVector3f End;
+		FColor Color;
+		float Thickness;
+		uint32 BatchId;
+	};
+
+	struct FStringRecord
+	{
+		FVector Location;
+		FString Text;
+		FColor Color;
+	};
+
+	void AddLineRecord(const FVector& Start, const FVector& End, const FColor& Color, float Thickness, uint32 BatchId);
+
+	EDebugDrawCategory EnabledCategories = EDebugDrawCategory::None;
+
+	TArray<FLineRecord> TransientLines;
+	TArray<FLineRecord> PersistentLines;
+	TArray<FStringRecord> Strings;
+
+	/** 持久批次当前的数据哈希 */
+	TMap<uint32, uint32> PersistentHashes;
+
+	/** 本帧需要重建的持久批次 */
+	TArray<uint32> DirtyBatches;
+
+	/** 提交时复用的批处理线段数组 */
+	TArray<FBatchedLine> ScratchLines;
+};
+
+#endif // ENABLE_DRAW_DEBUG
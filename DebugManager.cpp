@@ -1,9 +1,150 @@
 #include "DebugManager.h"
 #include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
+
+DEFINE_LOG_CATEGORY(LogSoul);
 
 // ǰ������
 class UPerformanceProfiler;
 
+// ==================== 模块日志开关 ====================
+
+EDebugLogLevel FSoulLog::ModuleLevels[FSoulLog::NumModules] =
+{
+	EDebugLogLevel::Warning, EDebugLogLevel::Warning, EDebugLogLevel::Warning, EDebugLogLevel::Warning,
+	EDebugLogLevel::Warning, EDebugLogLevel::Warning, EDebugLogLevel::Warning, EDebugLogLevel::Warning
+};
+
+// 与ModuleLevels的默认值一致：所有模块输出Error和Warning
+uint32 FSoulLog::EnabledModuleMasks[FSoulLog::NumLevels] =
+{
+	0,
+	(uint32)ESoulLogModule::All,
+	(uint32)ESoulLogModule::All,
+	0,
+	0,
+	0
+};
+
+static const TCHAR* SoulLogModuleNames[FSoulLog::NumModules] =
+{
+	TEXT("General"),
+	TEXT("LockOn"),
+	TEXT("Camera"),
+	TEXT("TargetDetection"),
+	TEXT("UI"),
+	TEXT("SocketProjection"),
+	TEXT("AdvancedCamera"),
+	TEXT("Performance")
+};
+
+void FSoulLog::SetModuleLevel(ESoulLogModule Modules, EDebugLogLevel Level)
+{
+	for (int32 Index = 0; Index < NumModules; ++Index)
+	{
+		if (((uint32)Modules & (1u << Index)) != 0)
+		{
+			ModuleLevels[Index] = Level;
+		}
+	}
+
+	RebuildMasks();
+}
+
+EDebugLogLevel FSoulLog::GetModuleLevel(ESoulLogModule Module)
+{
+	const uint32 Bits = (uint32)Module;
+	if (Bits == 0)
+		return EDebugLogLevel::None;
+
+	return ModuleLevels[FMath::CountTrailingZeros(Bits)];
+}
+
+const TCHAR* FSoulLog::GetModuleName(ESoulLogModule Module)
+{
+	const uint32 Bits = (uint32)Module;
+	if (Bits == 0 || Bits >= (1u << NumModules))
+		return TEXT("None");
+
+	return SoulLogModuleNames[FMath::CountTrailingZeros(Bits)];
+}
+
+ESoulLogModule FSoulLog::FindModuleByName(const FString& Name)
+{
+	if (Name.Equals(TEXT("All"), ESearchCase::IgnoreCase))
+		return ESoulLogModule::All;
+
+	for (int32 Index = 0; Index < NumModules; ++Index)
+	{
+		if (Name.Equals(SoulLogModuleNames[Index], ESearchCase::IgnoreCase))
+		{
+			return (ESoulLogModule)(1u << Index);
+		}
+	}
+
+	return ESoulLogModule::None;
+}
+
+void FSoulLog::RebuildMasks()
+{
+	for (int32 Level = 0; Level < NumLevels; ++Level)
+	{
+		uint32 Mask = 0;
+
+		// None级别不对应任何输出
+		if (Level > (int32)EDebugLogLevel::None)
+		{
+			for (int32 Index = 0; Index < NumModules; ++Index)
+			{
+				if ((int32)ModuleLevels[Index] >= Level)
+				{
+					Mask |= 1u << Index;
+				}
+			}
+		}
+
+		EnabledModuleMasks[Level] = Mask;
+	}
+}
+
+static FAutoConsoleCommand CmdSoulLogSetLevel(
+	TEXT("Soul.Log.SetLevel"),
+	TEXT("Set module log level: Soul.Log.SetLevel <Module|All> <0=None, 1=Error, 2=Warning, 3=Info, 4=Verbose, 5=VeryVerbose>"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		if (Args.Num() < 2)
+		{
+			UE_LOG(LogSoul, Warning, TEXT("Usage: Soul.Log.SetLevel <Module|All> <Level>"));
+			return;
+		}
+
+		const ESoulLogModule Module = FSoulLog::FindModuleByName(Args[0]);
+		if (Module == ESoulLogModule::None)
+		{
+			UE_LOG(LogSoul, Warning, TEXT("Soul.Log.SetLevel: Unknown module '%s'"), *Args[0]);
+			return;
+		}
+
+		const int32 Level = FMath::Clamp(FCString::Atoi(*Args[1]), 0, FSoulLog::NumLevels - 1);
+		FSoulLog::SetModuleLevel(Module, (EDebugLogLevel)Level);
+		UE_LOG(LogSoul, Warning, TEXT("Soul.Log.SetLevel: %s -> %s"), *Args[0], *UEnum::GetValueAsString((EDebugLogLevel)Level));
+	})
+);
+
+static FAutoConsoleCommand CmdSoulLogStatus(
+	TEXT("Soul.Log.Status"),
+	TEXT("Print the log level of every module"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		for (int32 Index = 0; Index < FSoulLog::NumModules; ++Index)
+		{
+			const ESoulLogModule Module = (ESoulLogModule)(1u << Index);
+			UE_LOG(LogSoul, Warning, TEXT("  %s: %s"), FSoulLog::GetModuleName(Module),
+				*UEnum::GetValueAsString(FSoulLog::GetModuleLevel(Module)));
+		}
+	})
+);
+
 // ���캯��ʵ��
 USoulDebugSettings::USoulDebugSettings()
 {
@@ -57,11 +198,13 @@ void USoulDebugSettings::EnableAllDebugLogs(bool bEnable)
 	MutableSettings->DebugSettings.bEnableAdvancedCameraDebugLogs = bEnable;
 	MutableSettings->DebugSettings.bEnablePerformanceMonitoring = bEnable;
 
+	ApplyToLogGate(MutableSettings->DebugSettings);
+
 	UE_LOG(LogTemp, Warning, TEXT("USoulDebugSettings::EnableAllDebugLogs: All debug logs %s"), 
 		bEnable ? TEXT("ENABLED") : TEXT("DISABLED"));
 }
 
-void USoulDebugSettings::EnableModuleDebugLogs(const FString& ModuleName, bool bEnable)
+void USoulDebugSettings::EnableModuleDebugLogs(ESoulLogModule Module, bool bEnable)
 {
 	// ��ȡ���޸ĵ�����ʵ��
 	USoulDebugSettings* MutableSettings = GetMutableDefault<USoulDebugSettings>();
@@ -72,43 +215,39 @@ void USoulDebugSettings::EnableModuleDebugLogs(const FString& ModuleName, bool b
 	}
 
 	// ����ģ�����������ض��ĵ�����־
-	if (ModuleName == TEXT("LockOn"))
+	switch (Module)
 	{
+	case ESoulLogModule::LockOn:
 		MutableSettings->DebugSettings.bEnableLockOnDebugLogs = bEnable;
-	}
-	else if (ModuleName == TEXT("Camera"))
-	{
+		break;
+	case ESoulLogModule::Camera:
 		MutableSettings->DebugSettings.bEnableCameraDebugLogs = bEnable;
-	}
-	else if (ModuleName == TEXT("TargetDetection"))
-	{
+		break;
+	case ESoulLogModule::TargetDetection:
 		MutableSettings->DebugSettings.bEnableTargetDetectionDebugLogs = bEnable;
-	}
-	else if (ModuleName == TEXT("UI"))
-	{
+		break;
+	case ESoulLogModule::UI:
 		MutableSettings->DebugSettings.bEnableUIDebugLogs = bEnable;
-	}
-	else if (ModuleName == TEXT("SocketProjection"))
-	{
+		break;
+	case ESoulLogModule::SocketProjection:
 		MutableSettings->DebugSettings.bEnableSocketProjectionDebugLogs = bEnable;
-	}
-	else if (ModuleName == TEXT("AdvancedCamera"))
-	{
+		break;
+	case ESoulLogModule::AdvancedCamera:
 		MutableSettings->DebugSettings.bEnableAdvancedCameraDebugLogs = bEnable;
-	}
-	else if (ModuleName == TEXT("Performance"))
-	{
+		break;
+	case ESoulLogModule::Performance:
 		MutableSettings->DebugSettings.bEnablePerformanceMonitoring = bEnable;
-	}
-	else
-	{
-		// ����δ֪ģ�飬Ӱ��ȫ�ֵĵ�����־
+		break;
+	default:
+		// 通用或组合模块，影响全局的调试日志
 		MutableSettings->DebugSettings.bEnableDebugLogs = bEnable;
-		UE_LOG(LogTemp, Warning, TEXT("USoulDebugSettings::EnableModuleDebugLogs: Unknown module '%s', affecting global debug logs"), *ModuleName);
+		break;
 	}
 
+	ApplyToLogGate(MutableSettings->DebugSettings);
+
 	UE_LOG(LogTemp, Warning, TEXT("USoulDebugSettings::EnableModuleDebugLogs: Module '%s' debug logs %s"), 
-		*ModuleName, bEnable ? TEXT("ENABLED") : TEXT("DISABLED"));
+		FSoulLog::GetModuleName(Module), bEnable ? TEXT("ENABLED") : TEXT("DISABLED"));
 }
 
 void USoulDebugSettings::SetGlobalLogLevel(EDebugLogLevel NewRequestedLogLevel)
@@ -124,6 +263,7 @@ void USoulDebugSettings::SetGlobalLogLevel(EDebugLogLevel NewRequestedLogLevel)
 	// �����µ�ȫ����־����
 	EDebugLogLevel OldLogLevel = MutableSettings->DebugSettings.GlobalLogLevel;
 	MutableSettings->DebugSettings.GlobalLogLevel = NewRequestedLogLevel;
+	ApplyToLogGate(MutableSettings->DebugSettings);
 
 	// �����־�����Ϣ
 	FString OldLevelName = UEnum::GetValueAsString(OldLogLevel);
@@ -132,4 +272,21 @@ void USoulDebugSettings::SetGlobalLogLevel(EDebugLogLevel NewRequestedLogLevel)
 		*OldLevelName, *NewLevelName);
 }
 
+void USoulDebugSettings::ApplyToLogGate(const FDebugSettings& Settings)
+{
+	auto GetModuleLevel = [&Settings](bool bModuleDebugLogs)
+	{
+		return (Settings.bEnableDebugLogs || bModuleDebugLogs) ? EDebugLogLevel::VeryVerbose : Settings.GlobalLogLevel;
+	};
+
+	FSoulLog::SetModuleLevel(ESoulLogModule::General, GetModuleLevel(false));
+	FSoulLog::SetModuleLevel(ESoulLogModule::LockOn, GetModuleLevel(Settings.bEnableLockOnDebugLogs));
+	FSoulLog::SetModuleLevel(ESoulLogModule::Camera, GetModuleLevel(Settings.bEnableCameraDebugLogs));
+	FSoulLog::SetModuleLevel(ESoulLogModule::TargetDetection, GetModuleLevel(Settings.bEnableTargetDetectionDebugLogs));
+	FSoulLog::SetModuleLevel(ESoulLogModule::UI, GetModuleLevel(Settings.bEnableUIDebugLogs));
+	FSoulLog::SetModuleLevel(ESoulLogModule::SocketProjection, GetModuleLevel(Settings.bEnableSocketProjectionDebugLogs));
+	FSoulLog::SetModuleLevel(ESoulLogModule::AdvancedCamera, GetModuleLevel(Settings.bEnableAdvancedCameraDebugLogs));
+	FSoulLog::SetModuleLevel(ESoulLogModule::Performance, GetModuleLevel(Settings.bEnablePerformanceMonitoring));
+}
+
 // ע�⣺FSoulPerformanceScope��ʵ�����ƶ���PerformanceProfiler.cpp��
\ No newline at end of file
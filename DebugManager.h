@@ -4,6 +4,8 @@
 #include "UObject/Object.h"
 #include "DebugManager.generated.h"
 
+DECLARE_LOG_CATEGORY_EXTERN(LogSoul, VeryVerbose, All);
+
 // ǰ������
 class UPerformanceProfiler;
 
@@ -21,6 +23,75 @@ enum class EDebugLogLevel : uint8
 	VeryVerbose		UMETA(DisplayName = "Very Verbose")
 };
 
+/** 日志模块（按位，可组合） */
+enum class ESoulLogModule : uint32
+{
+	None				= 0,
+	General				= 1 << 0,
+	LockOn				= 1 << 1,
+	Camera				= 1 << 2,
+	TargetDetection		= 1 << 3,
+	UI					= 1 << 4,
+	SocketProjection	= 1 << 5,
+	AdvancedCamera		= 1 << 6,
+	Performance			= 1 << 7,
+	All					= (1 << 8) - 1
+};
+ENUM_CLASS_FLAGS(ESoulLogModule);
+
+/**
+ * 模块日志开关
+ * 每个模块单独设置详细级别，并按级别预先合成模块位掩码，热路径上的检查只是一次读取与位测试。
+ * 高于SOUL_LOG_COMPILED_LEVEL的日志在编译期被移除。
+ */
+struct SOUL_API FSoulLog
+{
+	static constexpr int32 NumModules = 8;
+	static constexpr int32 NumLevels = (int32)EDebugLogLevel::VeryVerbose + 1;
+
+	/** 指定模块在该级别是否输出 */
+	static FORCEINLINE bool IsEnabled(ESoulLogModule Module, EDebugLogLevel Level)
+	{
+		return (EnabledModuleMasks[(uint8)Level] & (uint32)Module) != 0;
+	}
+
+	/** 设置一个或多个模块的详细级别 */
+	static void SetModuleLevel(ESoulLogModule Modules, EDebugLogLevel Level);
+
+	/** 获取单个模块的详细级别 */
+	static EDebugLogLevel GetModuleLevel(ESoulLogModule Module);
+
+	static const TCHAR* GetModuleName(ESoulLogModule Module);
+
+	/** 按名称查找模块（"All"返回所有模块，未找到返回None） */
+	static ESoulLogModule FindModuleByName(const FString& Name);
+
+private:
+	static void RebuildMasks();
+
+	/** 各模块的详细级别（按位序号索引） */
+	static EDebugLogLevel ModuleLevels[NumModules];
+
+	/** 每个级别下启用的模块掩码 */
+	static uint32 EnabledModuleMasks[NumLevels];
+};
+
+/** 日志限频器（每个调用点一个静态实例） */
+struct FSoulLogRateLimiter
+{
+	double NextAllowedTime = 0.0;
+
+	FORCEINLINE bool TryConsume(double IntervalSeconds)
+	{
+		const double CurrentTime = FPlatformTime::Seconds();
+		if (CurrentTime < NextAllowedTime)
+			return false;
+
+		NextAllowedTime = CurrentTime + IntervalSeconds;
+		return true;
+	}
+};
+
 /**
  * �������ýṹ��
  */
@@ -90,16 +161,28 @@ public:
 	/** ���û�������е�����־ */
 	static void EnableAllDebugLogs(bool bEnable);
 
-	/** ����ָ��ģ��ĵ�����־ */
-	static void EnableModuleDebugLogs(const FString& ModuleName, bool bEnable);
+	/** 设置指定模块的调试日志开关 */
+	static void EnableModuleDebugLogs(ESoulLogModule Module, bool bEnable);
 
-	/** ����Ƿ�Ӧ��Ϊָ��ģ�������־�����ݵ�����־���� */
-	static bool ShouldLogForModule(const FString& ModuleName, EDebugLogLevel RequestedLogLevel);
+	/** 检查是否应为指定模块输出该级别的日志 */
+	static FORCEINLINE bool ShouldLogForModule(ESoulLogModule Module, EDebugLogLevel RequestedLogLevel)
+	{
+		return FSoulLog::IsEnabled(Module, RequestedLogLevel);
+	}
 
 	/** ����ȫ����־���� */
 	static void SetGlobalLogLevel(EDebugLogLevel NewRequestedLogLevel);
+
+private:
+	/**
+	 * 把设置同步到模块日志开关
+	 * 全局级别作为所有模块的基础级别，开启了调试日志的模块输出全部级别
+	 */
+	static void ApplyToLogGate(const FDebugSettings& Settings);
 };
 
+#ifndef FSOUL_PERFORMANCE_SCOPE_DEFINED
+#define FSOUL_PERFORMANCE_SCOPE_DEFINED
 /**
  * ����������ṹ��
  * �����Զ���������ִ��ʱ��
@@ -107,73 +190,94 @@ public:
 struct SOUL_API FSoulPerformanceScope
 {
 public:
-	FSoulPerformanceScope(const FString& InFunctionName);
+	/** InFunctionName需在作用域内保持有效（通常为TEXT字面量） */
+	FSoulPerformanceScope(const TCHAR* InFunctionName);
 	~FSoulPerformanceScope();
 
 private:
-	FString FunctionName;
+	const TCHAR* FunctionName;
 	double StartTime;
+
+	/** 构造时有分析器开启监控，析构时计时并记录 */
+	bool bRecordTime = false;
+
+	/** 构造时SoulLockOn追踪通道已开启，析构时结束对应的Insights事件 */
+	bool bTraceEventOpen = false;
 };
+#endif
 
-// ==================== ���ܵ��Ժ궨�� ====================
+// ==================== 模块日志宏 ====================
 
 /**
- * ���ܵ��Ժ� - ���󼶱�
- * ֻ�е�ģ�����־��������ʱ�������־
+ * 编译期保留的最高日志级别（按EDebugLogLevel数值）
+ * Shipping/Test默认只保留Warning及以上，可在Build.cs中定义覆盖
  */
-#define SOUL_LOG_ERROR(ModuleName, Format, ...) \
-    if (USoulDebugSettings::ShouldLogForModule(ModuleName, EDebugLogLevel::Error)) \
-    { \
-        UE_LOG(LogTemp, Error, TEXT("[%s] ") Format, *ModuleName, ##__VA_ARGS__); \
-    }
+#ifndef SOUL_LOG_COMPILED_LEVEL
+	#if UE_BUILD_SHIPPING || UE_BUILD_TEST
+		#define SOUL_LOG_COMPILED_LEVEL 2
+	#else
+		#define SOUL_LOG_COMPILED_LEVEL 5
+	#endif
+#endif
 
-/**
- * ���ܵ��Ժ� - ���漶��
- * ֻ�е�ģ�����־��������ʱ�������־
- */
-#define SOUL_LOG_WARNING(ModuleName, Format, ...) \
-    if (USoulDebugSettings::ShouldLogForModule(ModuleName, EDebugLogLevel::Warning)) \
-    { \
-        UE_LOG(LogTemp, Warning, TEXT("[%s] ") Format, *ModuleName, ##__VA_ARGS__); \
-    }
+#define SOUL_LOG_IMPL(Module, Level, Verbosity, Format, ...) \
+	do \
+	{ \
+		if constexpr ((int32)EDebugLogLevel::Level <= SOUL_LOG_COMPILED_LEVEL) \
+		{ \
+			if (FSoulLog::IsEnabled(ESoulLogModule::Module, EDebugLogLevel::Level)) \
+			{ \
+				UE_LOG(LogSoul, Verbosity, TEXT("[") TEXT(#Module) TEXT("] ") Format, ##__VA_ARGS__); \
+			} \
+		} \
+	} while (0)
 
-/**
- * ���ܵ��Ժ� - ��Ϣ����
- * ֻ�е�ģ�����־��������ʱ�������־
- */
-#define SOUL_LOG_INFO(ModuleName, Format, ...) \
-    if (USoulDebugSettings::ShouldLogForModule(ModuleName, EDebugLogLevel::Info)) \
-    { \
-        UE_LOG(LogTemp, Log, TEXT("[%s] ") Format, *ModuleName, ##__VA_ARGS__); \
-    }
+#define SOUL_LOG_RATE_LIMITED_IMPL(Module, Level, Verbosity, IntervalSeconds, Format, ...) \
+	do \
+	{ \
+		if constexpr ((int32)EDebugLogLevel::Level <= SOUL_LOG_COMPILED_LEVEL) \
+		{ \
+			if (FSoulLog::IsEnabled(ESoulLogModule::Module, EDebugLogLevel::Level)) \
+			{ \
+				static FSoulLogRateLimiter RateLimiter; \
+				if (RateLimiter.TryConsume(IntervalSeconds)) \
+				{ \
+					UE_LOG(LogSoul, Verbosity, TEXT("[") TEXT(#Module) TEXT("] ") Format, ##__VA_ARGS__); \
+				} \
+			} \
+		} \
+	} while (0)
 
 /**
- * ���ܵ��Ժ� - ��ϸ����
- * ֻ�е�ģ�����־��������ʱ�������־
+ * 模块日志（Module为ESoulLogModule的枚举名，如Camera）
+ * 只有当模块的详细级别达到时才求值参数并输出
  */
-#define SOUL_LOG_VERBOSE(ModuleName, Format, ...) \
-    if (USoulDebugSettings::ShouldLogForModule(ModuleName, EDebugLogLevel::Verbose)) \
-    { \
-        UE_LOG(LogTemp, Verbose, TEXT("[%s] ") Format, *ModuleName, ##__VA_ARGS__); \
-    }
+#define SOUL_LOG_ERROR(Module, Format, ...)			SOUL_LOG_IMPL(Module, Error, Error, Format, ##__VA_ARGS__)
+#define SOUL_LOG_WARNING(Module, Format, ...)		SOUL_LOG_IMPL(Module, Warning, Warning, Format, ##__VA_ARGS__)
+#define SOUL_LOG_INFO(Module, Format, ...)			SOUL_LOG_IMPL(Module, Info, Log, Format, ##__VA_ARGS__)
+#define SOUL_LOG_VERBOSE(Module, Format, ...)		SOUL_LOG_IMPL(Module, Verbose, Verbose, Format, ##__VA_ARGS__)
+#define SOUL_LOG_VERY_VERBOSE(Module, Format, ...)	SOUL_LOG_IMPL(Module, VeryVerbose, VeryVerbose, Format, ##__VA_ARGS__)
 
 /**
- * ���ܵ��Ժ� - �ǳ���ϸ����
- * ֻ�е�ģ�����־��������ʱ�������־
+ * 限频的模块日志（每个调用点在IntervalSeconds内最多输出一次）
+ * 用于每帧执行的相机与检测路径
  */
-#define SOUL_LOG_VERY_VERBOSE(ModuleName, Format, ...) \
-    if (USoulDebugSettings::ShouldLogForModule(ModuleName, EDebugLogLevel::VeryVerbose)) \
-    { \
-        UE_LOG(LogTemp, VeryVerbose, TEXT("[%s] ") Format, *ModuleName, ##__VA_ARGS__); \
-    }
+#define SOUL_LOG_WARNING_RATE_LIMITED(Module, IntervalSeconds, Format, ...)			SOUL_LOG_RATE_LIMITED_IMPL(Module, Warning, Warning, IntervalSeconds, Format, ##__VA_ARGS__)
+#define SOUL_LOG_INFO_RATE_LIMITED(Module, IntervalSeconds, Format, ...)			SOUL_LOG_RATE_LIMITED_IMPL(Module, Info, Log, IntervalSeconds, Format, ##__VA_ARGS__)
+#define SOUL_LOG_VERBOSE_RATE_LIMITED(Module, IntervalSeconds, Format, ...)			SOUL_LOG_RATE_LIMITED_IMPL(Module, Verbose, Verbose, IntervalSeconds, Format, ##__VA_ARGS__)
+#define SOUL_LOG_VERY_VERBOSE_RATE_LIMITED(Module, IntervalSeconds, Format, ...)	SOUL_LOG_RATE_LIMITED_IMPL(Module, VeryVerbose, VeryVerbose, IntervalSeconds, Format, ##__VA_ARGS__)
 
 // ���ܼ�غ궨��
+#ifndef SOUL_PERFORMANCE_SCOPE
 #define SOUL_PERFORMANCE_SCOPE(FunctionName) \
 	FSoulPerformanceScope PerformanceScope(FunctionName)
+#endif
 
+#ifndef SOUL_PERFORMANCE_SCOPE_CONDITIONAL
 #define SOUL_PERFORMANCE_SCOPE_CONDITIONAL(FunctionName, Condition) \
 	TOptional<FSoulPerformanceScope> PerformanceScope; \
 	if (Condition) \
 	{ \
 		PerformanceScope.Emplace(FunctionName); \
-	}
\ No newline at end of file
+	}
+#endif
\ No newline at end of file
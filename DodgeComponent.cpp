@@ -86,6 +86,11 @@ void UDodgeComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActor
 	{
 		UpdateDodgeMovement(DeltaTime);
 	}
+	else if (bSafetyMapActive)
+	{
+		// 非闪避期间持续刷新方向安全图
+		UpdateSafetyMap();
+	}
 }
 
 // ==================== ���Ľӿں���ʵ�� ====================
@@ -156,14 +161,14 @@ bool UDodgeComponent::StartDodgeInDirection(EDodgeDirection Direction)
 	}
 	
 	// ��������Ŀ��λ��
-	FVector TargetLocation = CalculateDodgeTargetLocation(Direction);
+	const float SafeDistance = GetSafeDodgeDistance(Direction);
 	
 	// ���·����ȫ��
-	if (!IsPathSafe(GetOwner()->GetActorLocation(), TargetLocation))
+	if (SafeDistance < DodgeSettings.DodgeDistance * MinPartialDodgeRatio)
 	{
 		if (bEnableDebugLogs)
 		{
-			UE_LOG(LogTemp, Warning, TEXT("DodgeComponent: Dodge path is not safe"));
+			UE_LOG(LogTemp, Warning, TEXT("DodgeComponent: Dodge path is not safe (clearance %.1f)"), SafeDistance);
 		}
 		
 		// �˻������������StaminaComponent��
@@ -186,6 +191,9 @@ bool UDodgeComponent::StartDodgeInDirection(EDodgeDirection Direction)
 		return false;
 	}
 	
+	// 路径部分受阻时缩短到安全距离
+	FVector TargetLocation = GetOwner()->GetActorLocation() + GetDirectionVector(Direction) * SafeDistance;
+	
 	// ��������״̬
 	bIsDodging = true;
 	CurrentDodgeDirection = Direction;
@@ -642,20 +650,6 @@ void UDodgeComponent::PlayDodgeAnimation(EDodgeDirection Direction)
 	}
 }
 
-FVector UDodgeComponent::CalculateDodgeTargetLocation(EDodgeDirection Direction) const
-{
-	AActor* Owner = GetOwner();
-	if (!Owner)
-	{
-		return FVector::ZeroVector;
-	}
-	
-	FVector StartLocation = Owner->GetActorLocation();
-	FVector DirectionVector = GetDirectionVector(Direction);
-	
-	return StartLocation + (DirectionVector * DodgeSettings.DodgeDistance);
-}
-
 FVector UDodgeComponent::GetDirectionVector(EDodgeDirection Direction) const
 {
 	AActor* Owner = GetOwner();
@@ -698,23 +692,121 @@ FVector UDodgeComponent::GetDirectionVector(EDodgeDirection Direction) const
 	}
 }
 
-bool UDodgeComponent::IsPathSafe(const FVector& StartLocation, const FVector& EndLocation) const
+void UDodgeComponent::SetSafetyMapActive(bool bActive)
+{
+	if (bSafetyMapActive == bActive)
+	{
+		return;
+	}
+	
+	bSafetyMapActive = bActive;
+	
+	// 关闭后丢弃安全图和进行中的批次，重新开启时从头刷新
+	if (!bActive)
+	{
+		bSafetyMapValid = false;
+		bSafetyMapBatchPending = false;
+	}
+}
+
+float UDodgeComponent::GetSafeDodgeDistance(EDodgeDirection Direction) const
+{
+	AActor* Owner = GetOwner();
+	if (!Owner || Direction == EDodgeDirection::None)
+	{
+		return 0.0f;
+	}
+	
+	const FVector Location = Owner->GetActorLocation();
+	
+	// 安全图只在采样位置/朝向附近有效
+	if (bSafetyMapActive && bSafetyMapValid)
+	{
+		const float YawDrift = FMath::Abs(FMath::FindDeltaAngleDegrees(SafetyMapYaw, Owner->GetActorRotation().Yaw));
+		if (FVector::DistSquared(Location, SafetyMapOrigin) <= FMath::Square(SAFETY_MAP_MAX_LOCATION_DRIFT)
+			&& YawDrift <= SAFETY_MAP_MAX_YAW_DRIFT)
+		{
+			return SafetyMap[(int32)Direction - 1].SafeDistance;
+		}
+	}
+	
+	// 安全图不可用或已过期，同步检测
+	return SweepSafeDistance(Location, GetDirectionVector(Direction));
+}
+
+void UDodgeComponent::UpdateSafetyMap()
 {
 	UWorld* World = GetWorld();
-	if (!World)
+	AActor* Owner = GetOwner();
+	if (!World || !Owner)
 	{
-		return false;
+		return;
 	}
 	
-	// �������߼�⣬���·�����Ƿ����ϰ���
-	FHitResult HitResult;
+	// 拉取上一批结果，整批到齐才替换安全图
+	if (bSafetyMapBatchPending)
+	{
+		float BatchDistances[NUM_DODGE_DIRECTIONS];
+		bool bBatchComplete = true;
+		
+		for (int32 Index = 0; Index < NUM_DODGE_DIRECTIONS; ++Index)
+		{
+			FTraceDatum TraceDatum;
+			if (!World->QueryTraceData(SafetyMap[Index].Handle, TraceDatum))
+			{
+				bBatchComplete = false;
+				break;
+			}
+			BatchDistances[Index] = GetSafeDistanceFromHit(FHitResult::GetFirstBlockingHit(TraceDatum.OutHits));
+		}
+		
+		if (bBatchComplete)
+		{
+			for (int32 Index = 0; Index < NUM_DODGE_DIRECTIONS; ++Index)
+			{
+				SafetyMap[Index].SafeDistance = BatchDistances[Index];
+			}
+			SafetyMapOrigin = PendingSafetyMapOrigin;
+			SafetyMapYaw = PendingSafetyMapYaw;
+			bSafetyMapValid = true;
+		}
+		
+		// 异步结果只保留一帧，未到齐的批次直接丢弃重发
+		bSafetyMapBatchPending = false;
+	}
+	
+	// 发起下一批：8个方向一次性提交
+	const FVector StartLocation = Owner->GetActorLocation();
+	const FCollisionShape SweepShape = FCollisionShape::MakeSphere(GetDodgeSweepRadius());
+	
 	FCollisionQueryParams QueryParams;
-	QueryParams.AddIgnoredActor(GetOwner());
+	QueryParams.AddIgnoredActor(Owner);
 	QueryParams.bTraceComplex = false;
 	QueryParams.bReturnPhysicalMaterial = false;
 	
-	// ʹ�ý�ɫ������İ뾶��������׷��
-	float CapsuleRadius = 50.0f; // Ĭ�ϰ뾶
+	for (int32 Index = 0; Index < NUM_DODGE_DIRECTIONS; ++Index)
+	{
+		const FVector DirectionVector = GetDirectionVector((EDodgeDirection)(Index + 1));
+		SafetyMap[Index].Handle = World->AsyncSweepByChannel(
+			EAsyncTraceType::Single,
+			StartLocation,
+			StartLocation + DirectionVector * DodgeSettings.DodgeDistance,
+			FQuat::Identity,
+			ECC_WorldStatic,
+			SweepShape,
+			QueryParams
+		);
+	}
+	
+	PendingSafetyMapOrigin = StartLocation;
+	PendingSafetyMapYaw = Owner->GetActorRotation().Yaw;
+	bSafetyMapBatchPending = true;
+}
+
+float UDodgeComponent::GetDodgeSweepRadius() const
+{
+	// 使用角色胶囊体半径进行扫掠
+	float CapsuleRadius = 50.0f;
 	
 	ACharacter* Character = Cast<ACharacter>(GetOwner());
 	if (Character && Character->GetCapsuleComponent())
@@ -722,24 +814,54 @@ bool UDodgeComponent::IsPathSafe(const FVector& StartLocation, const FVector& En
 		CapsuleRadius = Character->GetCapsuleComponent()->GetScaledCapsuleRadius();
 	}
 	
+	return CapsuleRadius;
+}
+
+float UDodgeComponent::SweepSafeDistance(const FVector& StartLocation, const FVector& DirectionVector) const
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return 0.0f;
+	}
+	
+	FHitResult HitResult;
+	FCollisionQueryParams QueryParams;
+	QueryParams.AddIgnoredActor(GetOwner());
+	QueryParams.bTraceComplex = false;
+	QueryParams.bReturnPhysicalMaterial = false;
+	
 	bool bHit = World->SweepSingleByChannel(
 		HitResult,
 		StartLocation,
-		EndLocation,
+		StartLocation + DirectionVector * DodgeSettings.DodgeDistance,
 		FQuat::Identity,
 		ECC_WorldStatic,
-		FCollisionShape::MakeSphere(CapsuleRadius),
+		FCollisionShape::MakeSphere(GetDodgeSweepRadius()),
 		QueryParams
 	);
 	
-	// ���û��ײ�����κζ�����·���ǰ�ȫ��
-	bool bIsSafe = !bHit;
-	
-	if (bEnableDebugLogs && !bIsSafe)
+	if (bEnableDebugLogs && bHit)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("DodgeComponent: Dodge path blocked by: %s"), 
 			HitResult.GetActor() ? *HitResult.GetActor()->GetName() : TEXT("Unknown"));
 	}
 	
-	return bIsSafe;
-}
\ No newline at end of file
+	return GetSafeDistanceFromHit(bHit ? &HitResult : nullptr);
+}
+
+float UDodgeComponent::GetSafeDistanceFromHit(const FHitResult* BlockingHit) const
+{
+	if (!BlockingHit)
+	{
+		return DodgeSettings.DodgeDistance;
+	}
+	
+	// 起点已经嵌入障碍物时不能朝该方向闪避
+	if (BlockingHit->bStartPenetrating)
+	{
+		return 0.0f;
+	}
+	
+	return FMath::Max(0.0f, BlockingHit->Time * DodgeSettings.DodgeDistance - DODGE_CLEARANCE_SKIN);
+}
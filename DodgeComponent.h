@@ -8,6 +8,7 @@
 #include "Engine/DataTable.h"
 #include "Animation/AnimMontage.h"
 #include "Curves/CurveFloat.h"
+#include "WorldCollision.h"
 #include "DodgeComponent.generated.h"
 
 // ǰ������
@@ -181,6 +182,20 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Settings", meta = (ClampMin = "0.0", ClampMax = "100.0"))
 	float StaminaCost = 25.0f;
 
+	// 路径被挡住时允许的最短闪避距离（相对DodgeDistance的比例），不足时拒绝闪避
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Settings", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float MinPartialDodgeRatio = 0.25f;
+
+	// ==================== 方向安全图 ====================
+
+	// 开启/关闭8方向安全图的持续刷新（锁定或战斗中开启）
+	UFUNCTION(BlueprintCallable, Category = "Dodge")
+	void SetSafetyMapActive(bool bActive);
+
+	// 指定方向上可以闪避的距离（优先读取安全图，安全图不可用时同步检测）
+	UFUNCTION(BlueprintCallable, Category = "Dodge")
+	float GetSafeDodgeDistance(EDodgeDirection Direction) const;
+
 	// �Ƿ����õ�����־
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug")
 	bool bEnableDebugLogs = false;
@@ -226,6 +241,35 @@ protected:
 	// �޵�֡��ʱ�����
 	FTimerHandle InvincibilityTimerHandle;
 
+	// 安全图中单个方向的采样
+	struct FDodgeClearanceSample
+	{
+		FTraceHandle Handle;
+		float SafeDistance = 0.0f;
+	};
+
+	static constexpr int32 NUM_DODGE_DIRECTIONS = 8;
+
+	// 安全图相对采样时位置/朝向的最大偏差，超出时视为过期
+	static constexpr float SAFETY_MAP_MAX_LOCATION_DRIFT = 30.0f;
+	static constexpr float SAFETY_MAP_MAX_YAW_DRIFT = 10.0f;
+
+	// 安全距离与障碍物之间保留的间隙
+	static constexpr float DODGE_CLEARANCE_SKIN = 2.0f;
+
+	// 8方向安全图（按EDodgeDirection - 1索引）
+	FDodgeClearanceSample SafetyMap[NUM_DODGE_DIRECTIONS];
+
+	// 当前安全图与进行中批次的采样位置/朝向
+	FVector SafetyMapOrigin = FVector::ZeroVector;
+	float SafetyMapYaw = 0.0f;
+	FVector PendingSafetyMapOrigin = FVector::ZeroVector;
+	float PendingSafetyMapYaw = 0.0f;
+
+	bool bSafetyMapActive = false;
+	bool bSafetyMapValid = false;
+	bool bSafetyMapBatchPending = false;
+
 private:
 	// ==================== ˽�и������� ====================
 	
@@ -252,12 +296,18 @@ private:
 	// �������ܶ���
 	void PlayDodgeAnimation(EDodgeDirection Direction);
 
-	// ��������Ŀ��λ��
-	FVector CalculateDodgeTargetLocation(EDodgeDirection Direction) const;
-
 	// ��ȡ��������
 	FVector GetDirectionVector(EDodgeDirection Direction) const;
 
-	// �������·���Ƿ�ȫ
-	bool IsPathSafe(const FVector& StartLocation, const FVector& EndLocation) const;
+	// 拉取上一批异步扫掠结果并发起下一批（安全图开启时每帧调用）
+	void UpdateSafetyMap();
+
+	// 扫掠半径（角色胶囊体半径）
+	float GetDodgeSweepRadius() const;
+
+	// 同步扫掠求安全距离（安全图不可用时的回退）
+	float SweepSafeDistance(const FVector& StartLocation, const FVector& DirectionVector) const;
+
+	// 由扫掠结果换算安全距离
+	float GetSafeDistanceFromHit(const FHitResult* BlockingHit) const;
 };
\ No newline at end of file
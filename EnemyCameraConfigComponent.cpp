@@ -30,6 +30,9 @@ void UEnemyCameraConfigComponent::BeginPlay()
 	// 验证设置的有效性
 	ValidateSettings();
 	
+	// 解析一次相机配置档，锁定期间相机直接读取
+	RebuildResolvedProfile();
+	
 	// 如果启用了调试，输出配置信息
 	if (bEnableDebugInfo)
 	{
@@ -78,6 +81,7 @@ FCameraTypeConfig UEnemyCameraConfigComponent::GetCameraConfig() const
 void UEnemyCameraConfigComponent::SetCameraType(EEnemyCameraType NewType)
 {
 	CameraType = NewType;
+	RebuildResolvedProfile();
 	
 	if (bEnableDebugInfo)
 	{
@@ -116,6 +120,52 @@ float UEnemyCameraConfigComponent::GetEffectivePitchOffset() const
 	return GetDefaultConfigForType(CameraType).PitchOffset;
 }
 
+// ==================== 已解析配置档 ====================
+
+void UEnemyCameraConfigComponent::RebuildResolvedProfile()
+{
+	ResolvedProfile.CameraType = CameraType;
+	ResolvedProfile.Config = GetCameraConfig();
+	
+	// 体型分类与相机的包围盒分类保持一致；没有Owner时（如编辑模板）按相机类型推断
+	AActor* OwnerActor = GetOwner();
+	if (OwnerActor)
+	{
+		FVector Origin, BoxExtent;
+		OwnerActor->GetActorBounds(false, Origin, BoxExtent);
+		ResolvedProfile.SizeCategory = ClassifySizeFromExtent(BoxExtent);
+	}
+	else
+	{
+		switch (CameraType)
+		{
+		case EEnemyCameraType::Small: ResolvedProfile.SizeCategory = EEnemySizeCategory::Small; break;
+		case EEnemyCameraType::Large: ResolvedProfile.SizeCategory = EEnemySizeCategory::Large; break;
+		case EEnemyCameraType::Giant:
+		case EEnemyCameraType::Boss: ResolvedProfile.SizeCategory = EEnemySizeCategory::Giant; break;
+		default: ResolvedProfile.SizeCategory = EEnemySizeCategory::Medium; break;
+		}
+	}
+	
+	ResolvedProfile.bIsResolved = true;
+}
+
+EEnemySizeCategory UEnemyCameraConfigComponent::ClassifySizeFromExtent(const FVector& BoxExtent)
+{
+	float Height = BoxExtent.Z * 2.0f;
+	float Volume = BoxExtent.X * BoxExtent.Y * BoxExtent.Z * 8.0f;
+	
+	// 基于体积和高度的分类
+	if (Height > 500.0f || Volume > 1000000.0f)
+		return EEnemySizeCategory::Giant;
+	else if (Height > 300.0f || Volume > 300000.0f)
+		return EEnemySizeCategory::Large;
+	else if (Height > 150.0f || Volume > 100000.0f)
+		return EEnemySizeCategory::Medium;
+	else
+		return EEnemySizeCategory::Small;
+}
+
 // ==================== 静态默认配置 ====================
 
 FCameraTypeConfig UEnemyCameraConfigComponent::GetDefaultConfigForType(EEnemyCameraType Type)
@@ -187,6 +237,7 @@ void UEnemyCameraConfigComponent::ResetCustomSettingsToDefault()
 	CustomFOVAdjustment = 0.0f;
 	CustomTrackingSpeed = 0.0f;
 	CustomSwitchSpeed = 0.0f;
+	RebuildResolvedProfile();
 	
 	UE_LOG(LogTemp, Warning, TEXT("Enemy Camera Config: Custom settings reset to default"));
 }
@@ -234,6 +285,7 @@ void UEnemyCameraConfigComponent::DebugPrintCurrentConfig()
 	UE_LOG(LogTemp, Warning, TEXT("  - FOV Adjustment: %.1f"), Config.FOVAdjustment);
 	UE_LOG(LogTemp, Warning, TEXT("  - Tracking Speed: %.1f"), Config.TrackingSpeed);
 	UE_LOG(LogTemp, Warning, TEXT("  - Switch Speed: %.1f"), Config.SwitchSpeed);
+	UE_LOG(LogTemp, Warning, TEXT("Resolved Size Category: %s"), *UEnum::GetValueAsString(ResolvedProfile.SizeCategory));
 	UE_LOG(LogTemp, Warning, TEXT("====================================="));
 }
 
@@ -297,6 +349,9 @@ void UEnemyCameraConfigComponent::PostEditChangeProperty(FPropertyChangedEvent&
 		
 		// 验证设置
 		ValidateSettings();
+		
+		// 编辑后重新解析，PIE中锁定该敌人的相机立即生效
+		RebuildResolvedProfile();
 	}
 }
 #endif
\ No newline at end of file
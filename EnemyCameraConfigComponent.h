@@ -153,6 +153,18 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Enemy Camera Config")
 	float GetEffectivePitchOffset() const;
 
+	// ==================== 已解析配置档 ====================
+	
+	/** 获取已解析的相机配置档（BeginPlay及编辑时计算，相机锁定期间直接读取） */
+	const FResolvedEnemyCameraProfile& GetResolvedProfile() const { return ResolvedProfile; }
+
+	/** 重新解析相机配置档（运行时通过蓝图修改配置后调用） */
+	UFUNCTION(BlueprintCallable, Category = "Enemy Camera Config")
+	void RebuildResolvedProfile();
+
+	/** 根据包围盒半尺寸进行体型分类 */
+	static EEnemySizeCategory ClassifySizeFromExtent(const FVector& BoxExtent);
+
 	// ==================== 静态默认配置 ====================
 	
 	/** 获取指定类型的默认相机配置 */
@@ -188,6 +200,9 @@ private:
 	/** 验证配置数值的有效性 */
 	void ValidateSettings();
 
+	/** 已解析的相机配置档 */
+	FResolvedEnemyCameraProfile ResolvedProfile;
+
 #if WITH_EDITOR
 	// ==================== 编辑器支持 ====================
 	
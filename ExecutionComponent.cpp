@@ -11,6 +11,7 @@
 #include "Kismet/KismetMathLibrary.h"
 #include "TimerManager.h"
 #include "CollisionQueryParams.h"
+#include "BackstabScannerSubsystem.h"
 
 // Sets default values for this component's properties
 UExecutionComponent::UExecutionComponent()
@@ -39,12 +40,35 @@ void UExecutionComponent::BeginPlay()
 	
 	// ��ʼ������ϵͳ
 	ResetExecutionState();
+
+	VerticalProbe.Initialize(GetOwner());
+
+	// 背刺机会由世界子系统统一扫描
+	if (UBackstabScannerSubsystem* Scanner = GetWorld()->GetSubsystem<UBackstabScannerSubsystem>())
+	{
+		Scanner->RegisterScanner(this);
+	}
 	
 	UE_LOG(LogTemp, Warning, TEXT("ExecutionComponent: Component initialized successfully"));
 	UE_LOG(LogTemp, Warning, TEXT("ExecutionComponent: BackstabRange=%.1f, BackstabAngle=%.1f"), 
 		ExecutionSettings.BackstabRange, ExecutionSettings.BackstabAngle);
 }
 
+void UExecutionComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UWorld* World = GetWorld())
+	{
+		if (UBackstabScannerSubsystem* Scanner = World->GetSubsystem<UBackstabScannerSubsystem>())
+		{
+			Scanner->UnregisterScanner(this);
+		}
+	}
+
+	SetBackstabOpportunityTarget(nullptr);
+
+	Super::EndPlay(EndPlayReason);
+}
+
 // Called every frame
 void UExecutionComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
@@ -62,18 +86,8 @@ void UExecutionComponent::TickComponent(float DeltaTime, ELevelTick TickType, FA
 		UpdatePositioning(DeltaTime);
 	}
 
-	// ���ڼ�鱳�̻��ᣨ����Ƶ�����Ż����ܣ�
-	static float LastBackstabCheckTime = 0.0f;
-	float CurrentTime = GetWorld()->GetTimeSeconds();
-	if (CurrentTime - LastBackstabCheckTime > 0.2f) // ÿ0.2����һ��
-	{
-		// ��鸽���Ƿ��пɱ��̵�Ŀ��
-		TArray<AActor*> NearbyActors;
-		// ����������Ӹ����ӵ�Ŀ�������߼�
-		// Ϊ�˱�����������ԣ���ʱ��������ʵ��
-		
-		LastBackstabCheckTime = CurrentTime;
-	}
+	// 竖直探测：只在空中时发起射线
+	VerticalProbe.Tick(IsCharacterInAir(), ExecutionSettings.PlungeHeightRequirement * 2.0f);
 }
 
 // ==================== ���Ľӿں���ʵ�� ====================
@@ -250,6 +264,53 @@ FVector UExecutionComponent::GetOptimalBackstabPosition(AActor* Target) const
 	return GetBackstabPositionBehindTarget(Target);
 }
 
+void UExecutionComponent::UpdateBackstabOpportunity(TConstArrayView<ACharacter*> NearbyCharacters)
+{
+	AActor* BestTarget = nullptr;
+
+	if (bEnableBackstabScan && !IsExecuting() && GetOwner())
+	{
+		const FVector OwnerLocation = GetOwner()->GetActorLocation();
+		const float RangeSquared = FMath::Square(ExecutionSettings.BackstabRange);
+		float BestDistanceSquared = TNumericLimits<float>::Max();
+
+		// 先用距离平方粗筛，只对更近的候选做完整判定（距离、角度、可被背刺）
+		for (ACharacter* Candidate : NearbyCharacters)
+		{
+			const float DistanceSquared = FVector::DistSquared(OwnerLocation, Candidate->GetActorLocation());
+			if (DistanceSquared > RangeSquared || DistanceSquared >= BestDistanceSquared)
+				continue;
+
+			if (CheckBackstabOpportunity(Candidate))
+			{
+				BestTarget = Candidate;
+				BestDistanceSquared = DistanceSquared;
+			}
+		}
+	}
+
+	SetBackstabOpportunityTarget(BestTarget);
+}
+
+void UExecutionComponent::SetBackstabOpportunityTarget(AActor* NewTarget)
+{
+	AActor* OldTarget = BackstabOpportunityTarget.Get();
+	if (OldTarget == NewTarget)
+		return;
+
+	BackstabOpportunityTarget = NewTarget;
+
+	if (OldTarget)
+	{
+		OnBackstabOpportunityClosed.Broadcast(OldTarget);
+	}
+
+	if (NewTarget)
+	{
+		OnBackstabOpportunity.Broadcast(NewTarget);
+	}
+}
+
 // ==================== ����ϵͳ����ʵ�� ====================
 
 bool UExecutionComponent::CanRiposte(AActor* Target) const
@@ -332,40 +393,12 @@ TArray<AActor*> UExecutionComponent::GetPlungeTargets() const
 {
 	TArray<AActor*> PlungeTargets;
 
-	if (!GetOwner())
+	// 读取竖直探测缓存（空中时每帧异步更新）
+	VerticalProbe.GetPawnsBelow(PlungeTargets);
+	PlungeTargets.RemoveAll([this](AActor* Candidate)
 	{
-		return PlungeTargets;
-	}
-
-	// �ӽ�ɫλ���������߼��
-	FVector StartLocation = GetOwner()->GetActorLocation();
-	FVector EndLocation = StartLocation - FVector(0.0f, 0.0f, ExecutionSettings.PlungeHeightRequirement * 2.0f);
-
-	// �������߼�����
-	FCollisionQueryParams QueryParams;
-	QueryParams.AddIgnoredActor(GetOwner());
-	QueryParams.bTraceComplex = false;
-
-	// ִ�����߼��
-	TArray<FHitResult> HitResults;
-	bool bHit = GetWorld()->LineTraceMultiByChannel(
-		HitResults,
-		StartLocation,
-		EndLocation,
-		ECC_Pawn,
-		QueryParams
-	);
-
-	if (bHit)
-	{
-		for (const FHitResult& Hit : HitResults)
-		{
-			if (Hit.GetActor() && ValidateExecutionTarget(Hit.GetActor()))
-			{
-				PlungeTargets.Add(Hit.GetActor());
-			}
-		}
-	}
+		return !ValidateExecutionTarget(Candidate);
+	});
 
 	return PlungeTargets;
 }
@@ -500,33 +533,8 @@ float UExecutionComponent::GetCharacterHeight() const
 
 float UExecutionComponent::GetDistanceToGround() const
 {
-	if (!GetOwner())
-	{
-		return 0.0f;
-	}
-
-	FVector StartLocation = GetOwner()->GetActorLocation();
-	FVector EndLocation = StartLocation - FVector(0.0f, 0.0f, 10000.0f); // ����100��
-
-	FCollisionQueryParams QueryParams;
-	QueryParams.AddIgnoredActor(GetOwner());
-	QueryParams.bTraceComplex = false;
-
-	FHitResult HitResult;
-	bool bHit = GetWorld()->LineTraceSingleByChannel(
-		HitResult,
-		StartLocation,
-		EndLocation,
-		ECC_WorldStatic,
-		QueryParams
-	);
-
-	if (bHit)
-	{
-		return FVector::Dist(StartLocation, HitResult.Location);
-	}
-
-	return 0.0f;
+	// 读取竖直探测缓存（在地面或尚无结果时为0）
+	return VerticalProbe.GetGroundDistance();
 }
 
 float UExecutionComponent::CalculateAngleBetweenActors(AActor* Actor1, AActor* Actor2) const
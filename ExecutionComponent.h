@@ -8,11 +8,13 @@
 #include "Animation/AnimMontage.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "TimerManager.h"
+#include "VerticalProbeCache.h"
 #include "ExecutionComponent.generated.h"
 
 // ǰ������
 class AActor;
 class UAnimMontage;
+class ACharacter;
 
 /** ��������ö�� */
 UENUM(BlueprintType)
@@ -85,6 +87,9 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnExecutionCompleted, AActor*, Tar
 /** ���̻����¼�ί�� */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnBackstabOpportunity, AActor*, Target);
 
+/** 背刺机会消失事件委托 */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnBackstabOpportunityClosed, AActor*, Target);
+
 /**
  * ���̴������
  * ���������̡�������׹�乥���ȴ���ϵͳ����
@@ -101,6 +106,7 @@ public:
 protected:
 	// Called when the game starts
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	// ==================== �������� ====================
 	/** ���̶�λ��ֵ�ٶ� */
@@ -140,6 +146,10 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Execution Events")
 	FOnBackstabOpportunity OnBackstabOpportunity;
 
+	/** 背刺机会消失事件 */
+	UPROPERTY(BlueprintAssignable, Category = "Execution Events")
+	FOnBackstabOpportunityClosed OnBackstabOpportunityClosed;
+
 	// ==================== ���Ľӿں��� ====================
 	/** ����Ƿ����ִ��ָ�����͵Ĵ��� */
 	UFUNCTION(BlueprintCallable, Category = "Execution")
@@ -170,6 +180,17 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Backstab")
 	FVector GetOptimalBackstabPosition(AActor* Target) const;
 
+	/** 是否参与背刺机会扫描 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Backstab")
+	bool bEnableBackstabScan = true;
+
+	/** 当前的背刺机会目标（没有时为空） */
+	UFUNCTION(BlueprintCallable, Category = "Backstab")
+	AActor* GetBackstabOpportunityTarget() const { return BackstabOpportunityTarget.Get(); }
+
+	/** 用邻近角色批量判定背刺机会，机会出现或消失时触发事件（由UBackstabScannerSubsystem调用） */
+	void UpdateBackstabOpportunity(TConstArrayView<ACharacter*> NearbyCharacters);
+
 	// ==================== ����ϵͳ���� ====================
 	/** ����Ƿ���Ե��� */
 	UFUNCTION(BlueprintCallable, Category = "Riposte")
@@ -237,6 +258,15 @@ protected:
 	/** Ŀ�괦��λ�� */
 	FVector TargetExecutionPosition = FVector::ZeroVector;
 
+	/** 当前的背刺机会目标 */
+	TWeakObjectPtr<AActor> BackstabOpportunityTarget;
+
+	/** 竖直探测缓存（坠落攻击目标与离地距离） */
+	FVerticalProbeCache VerticalProbe;
+
+	/** 切换背刺机会目标并触发对应事件 */
+	void SetBackstabOpportunityTarget(AActor* NewTarget);
+
 	// ==================== ˽�и������� ====================
 	/** ��֤����Ŀ�����Ч�� */
 	bool ValidateExecutionTarget(AActor* Target) const;
@@ -0,0 +1,584 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "InputReplayComponent.h"
+#include "MyCharacter.h"
+#include "PerformanceProfiler.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/UObjectIterator.h"
+
+// ==================== 控制台命令 ====================
+
+/** 对当前游戏世界中本地玩家的回放组件执行操作 */
+static void ForEachLocalReplayComponent(TFunctionRef<void(UInputReplayComponent*)> Func)
+{
+	for (TObjectIterator<UInputReplayComponent> It; It; ++It)
+	{
+		UWorld* World = It->GetWorld();
+		if (!World || !World->IsGameWorld() || World->bIsTearingDown)
+			continue;
+
+		APawn* OwnerPawn = Cast<APawn>(It->GetOwner());
+		if (OwnerPawn && OwnerPawn->IsLocallyControlled())
+		{
+			Func(*It);
+		}
+	}
+}
+
+static FAutoConsoleCommand CmdReplayRecord(
+	TEXT("Soul.Replay.Record"),
+	TEXT("Start recording input for deterministic replay. Usage: Soul.Replay.Record [Name]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const FString ReplayName = Args.Num() > 0 ? Args[0] : FString();
+		ForEachLocalReplayComponent([&ReplayName](UInputReplayComponent* Replay)
+		{
+			Replay->StartRecording(ReplayName);
+		});
+	})
+);
+
+static FAutoConsoleCommand CmdReplayPlay(
+	TEXT("Soul.Replay.Play"),
+	TEXT("Play back a recorded input replay with a fixed timestep. Usage: Soul.Replay.Play <Name>"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		if (Args.Num() == 0)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Soul.Replay.Play: Missing replay name"));
+			return;
+		}
+
+		ForEachLocalReplayComponent([&Args](UInputReplayComponent* Replay)
+		{
+			Replay->StartPlayback(Args[0]);
+		});
+	})
+);
+
+static FAutoConsoleCommand CmdReplayStop(
+	TEXT("Soul.Replay.Stop"),
+	TEXT("Stop the current input recording or playback"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		ForEachLocalReplayComponent([](UInputReplayComponent* Replay)
+		{
+			Replay->Stop();
+		});
+	})
+);
+
+UInputReplayComponent::UInputReplayComponent()
+{
+	// 只在录制或回放时Tick
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PrePhysics;
+}
+
+void UInputReplayComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// 回放需要在角色Tick之前注入输入
+	if (AActor* OwnerActor = GetOwner())
+	{
+		OwnerActor->AddTickPrerequisiteComponent(this);
+	}
+
+	// 命令行回放：控制器在BeginPlay之后才完成Possess，因此延迟到首次Tick启动
+	if (FParse::Value(FCommandLine::Get(), TEXT("SoulReplay="), CommandLineReplayName))
+	{
+		bExitOnPlaybackEnd = FParse::Param(FCommandLine::Get(), TEXT("SoulReplayExit"));
+		SetComponentTickEnabled(true);
+	}
+}
+
+void UInputReplayComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// 录制中途结束时仍然保存已录制的内容
+	if (ReplayState != EInputReplayState::Idle)
+	{
+		bExitOnPlaybackEnd = false;
+		Stop();
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UInputReplayComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (!CommandLineReplayName.IsEmpty() && GetOwnerController())
+	{
+		const FString ReplayName = CommandLineReplayName;
+		CommandLineReplayName.Empty();
+		if (!StartPlayback(ReplayName) && bExitOnPlaybackEnd)
+		{
+			FPlatformMisc::RequestExit(false);
+		}
+		return;
+	}
+
+	APlayerController* PlayerController = GetOwnerController();
+
+	if (ReplayState == EInputReplayState::Recording)
+	{
+		// 本组件在控制器处理输入之后Tick，此时当前帧的输入与旋转已经确定
+		PendingFrame.DeltaTime = DeltaTime;
+		if (PlayerController)
+		{
+			PendingFrame.ControlRotation = PlayerController->GetControlRotation();
+		}
+		Frames.Add(PendingFrame);
+
+		// 轴输入每帧都会重新调用，动作只属于当前帧
+		PendingFrame.Actions = EReplayInputAction::None;
+	}
+	else if (ReplayState == EInputReplayState::Playing)
+	{
+		// 本组件在控制器之前Tick，此时控制器旋转反映的是上一回放帧的结果
+		if (PlaybackFrameIndex > 0 && PlayerController)
+		{
+			const FRotator& RecordedRotation = Frames[PlaybackFrameIndex - 1].ControlRotation;
+			const FRotator Delta = (PlayerController->GetControlRotation() - RecordedRotation).GetNormalized();
+			MaxRotationDivergence = FMath::Max(MaxRotationDivergence, FMath::Max(FMath::Abs(Delta.Pitch), FMath::Abs(Delta.Yaw)));
+		}
+
+		if (PlaybackFrameIndex >= Frames.Num())
+		{
+			FinishPlayback();
+			return;
+		}
+
+		if (AMyCharacter* Character = GetOwnerCharacter())
+		{
+			Character->ApplyReplayFrame(Frames[PlaybackFrameIndex]);
+		}
+		++PlaybackFrameIndex;
+
+		// 下一引擎帧使用下一回放帧录制时的帧时间，与录制逐帧对齐
+		if (Frames.IsValidIndex(PlaybackFrameIndex))
+		{
+			FApp::SetFixedDeltaTime(Frames[PlaybackFrameIndex].DeltaTime);
+		}
+	}
+}
+
+// ==================== 录制与回放 ====================
+
+bool UInputReplayComponent::StartRecording(const FString& ReplayName)
+{
+	if (ReplayState != EInputReplayState::Idle)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("InputReplay: Cannot start recording while %s"), *UEnum::GetValueAsString(ReplayState));
+		return false;
+	}
+
+	AMyCharacter* Character = GetOwnerCharacter();
+	APlayerController* PlayerController = GetOwnerController();
+	if (!Character || !PlayerController)
+	{
+		UE_LOG(LogTemp, Error, TEXT("InputReplay: Recording requires a player controlled AMyCharacter"));
+		return false;
+	}
+
+	ActiveReplayName = ReplayName.IsEmpty() ? FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S")) : ReplayName;
+
+	// 固定随机种子，回放时复用
+	RandomSeed = (int32)(FPlatformTime::Cycles() & 0x7FFFFFFF);
+	FMath::RandInit(RandomSeed);
+	FMath::SRandInit(RandomSeed);
+
+	StartTransform = Character->GetActorTransform();
+	StartControlRotation = PlayerController->GetControlRotation();
+	CaptureActorStates();
+
+	Frames.Reset();
+	PendingFrame = FInputReplayFrame();
+
+	// 录制同样使用固定步长，回放才能逐帧复现相同的帧时间
+	BeginFixedTimeStep(PlaybackFixedDeltaTime);
+
+	SetControllerTickOrder(false);
+	ReplayState = EInputReplayState::Recording;
+	SetComponentTickEnabled(true);
+
+	UE_LOG(LogTemp, Warning, TEXT("InputReplay: Recording '%s' (Seed=%d, Actors=%d)"),
+		*ActiveReplayName, RandomSeed, ActorStates.Num());
+	return true;
+}
+
+bool UInputReplayComponent::StartPlayback(const FString& ReplayName)
+{
+	if (ReplayState != EInputReplayState::Idle)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("InputReplay: Cannot start playback while %s"), *UEnum::GetValueAsString(ReplayState));
+		return false;
+	}
+
+	AMyCharacter* Character = GetOwnerCharacter();
+	APlayerController* PlayerController = GetOwnerController();
+	if (!Character || !PlayerController)
+	{
+		UE_LOG(LogTemp, Error, TEXT("InputReplay: Playback requires a player controlled AMyCharacter"));
+		return false;
+	}
+
+	const FString FilePath = GetReplayFilePath(ReplayName);
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *FilePath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("InputReplay: Failed to read %s"), *FilePath);
+		return false;
+	}
+
+	FMemoryReader Reader(Data);
+	SerializeReplay(Reader);
+	if (Reader.IsError())
+	{
+		UE_LOG(LogTemp, Error, TEXT("InputReplay: %s is not a valid replay (version %u expected)"), *FilePath, REPLAY_VERSION);
+		Frames.Reset();
+		ActorStates.Reset();
+		return false;
+	}
+
+	ActiveReplayName = ReplayName;
+
+	// 恢复录制开始时的随机种子与场景状态
+	FMath::RandInit(RandomSeed);
+	FMath::SRandInit(RandomSeed);
+	RestoreActorStates();
+	Character->SetActorTransform(StartTransform, false, nullptr, ETeleportType::TeleportPhysics);
+	PlayerController->SetControlRotation(StartControlRotation);
+
+	// 固定步长并按录制的帧时间推进，保证不同机器/版本上的逐帧结果一致
+	BeginFixedTimeStep(Frames.Num() > 0 ? Frames[0].DeltaTime : PlaybackFixedDeltaTime);
+
+	// 回放期间屏蔽实时输入
+	Character->DisableInput(PlayerController);
+
+	PlaybackFrameIndex = 0;
+	MaxRotationDivergence = 0.0f;
+
+	SetControllerTickOrder(true);
+	ReplayState = EInputReplayState::Playing;
+	SetComponentTickEnabled(true);
+
+	UE_LOG(LogTemp, Warning, TEXT("InputReplay: Playing '%s' (%d frames, Seed=%d, FixedDelta=%.4f)"),
+		*ActiveReplayName, Frames.Num(), RandomSeed, FApp::GetFixedDeltaTime());
+	return true;
+}
+
+void UInputReplayComponent::Stop()
+{
+	if (ReplayState == EInputReplayState::Recording)
+	{
+		ClearControllerTickOrder();
+		ReplayState = EInputReplayState::Idle;
+		SetComponentTickEnabled(false);
+		EndFixedTimeStep();
+
+		TArray<uint8> Data;
+		FMemoryWriter Writer(Data);
+		SerializeReplay(Writer);
+
+		const FString FilePath = GetReplayFilePath(ActiveReplayName);
+		if (FFileHelper::SaveArrayToFile(Data, *FilePath))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("InputReplay: Saved %d frames (%d bytes) to %s"),
+				Frames.Num(), Data.Num(), *FilePath);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Error, TEXT("InputReplay: Failed to write %s"), *FilePath);
+		}
+	}
+	else if (ReplayState == EInputReplayState::Playing)
+	{
+		FinishPlayback();
+	}
+}
+
+void UInputReplayComponent::RecordAxis(EReplayInputAxis Axis, float Value)
+{
+	if (ReplayState == EInputReplayState::Recording && Axis < EReplayInputAxis::Count)
+	{
+		PendingFrame.Axes[(int32)Axis] = Value;
+	}
+}
+
+void UInputReplayComponent::RecordAction(EReplayInputAction Action)
+{
+	if (ReplayState == EInputReplayState::Recording)
+	{
+		PendingFrame.Actions |= Action;
+	}
+}
+
+FString UInputReplayComponent::GetReplayFilePath(const FString& ReplayName)
+{
+	return FPaths::ProjectSavedDir() / TEXT("Replays") / (ReplayName + TEXT(".soulreplay"));
+}
+
+// ==================== 内部函数 ====================
+
+void UInputReplayComponent::SerializeReplay(FArchive& Ar)
+{
+	uint32 Magic = REPLAY_MAGIC;
+	uint32 Version = REPLAY_VERSION;
+	Ar << Magic;
+	Ar << Version;
+	if (Ar.IsLoading() && (Magic != REPLAY_MAGIC || Version != REPLAY_VERSION))
+	{
+		Ar.SetError();
+		return;
+	}
+
+	Ar << RandomSeed;
+	Ar << StartTransform;
+	Ar << StartControlRotation;
+
+	int32 NumActors = ActorStates.Num();
+	Ar << NumActors;
+	if (Ar.IsLoading())
+	{
+		if (NumActors < 0 || NumActors > Ar.TotalSize())
+		{
+			Ar.SetError();
+			return;
+		}
+		ActorStates.SetNum(NumActors);
+	}
+
+	for (FInputReplayActorState& State : ActorStates)
+	{
+		Ar << State.ActorName;
+		Ar << State.ClassPath;
+		Ar << State.Transform;
+	}
+
+	int32 NumFrames = Frames.Num();
+	Ar << NumFrames;
+	if (Ar.IsLoading())
+	{
+		if (NumFrames < 0 || NumFrames > Ar.TotalSize())
+		{
+			Ar.SetError();
+			return;
+		}
+		Frames.SetNum(NumFrames);
+	}
+
+	// 轴输入大多数帧保持不变，只写入变化的值
+	FInputReplayFrame Previous;
+	for (FInputReplayFrame& Frame : Frames)
+	{
+		uint8 ChangedMask = 0;
+		if (Ar.IsSaving())
+		{
+			for (int32 AxisIndex = 0; AxisIndex < (int32)EReplayInputAxis::Count; ++AxisIndex)
+			{
+				if (Frame.Axes[AxisIndex] != Previous.Axes[AxisIndex])
+				{
+					ChangedMask |= 1 << AxisIndex;
+				}
+			}
+		}
+		Ar << ChangedMask;
+
+		for (int32 AxisIndex = 0; AxisIndex < (int32)EReplayInputAxis::Count; ++AxisIndex)
+		{
+			if (ChangedMask & (1 << AxisIndex))
+			{
+				Ar << Frame.Axes[AxisIndex];
+			}
+			else
+			{
+				Frame.Axes[AxisIndex] = Previous.Axes[AxisIndex];
+			}
+		}
+
+		uint8 Actions = (uint8)Frame.Actions;
+		Ar << Actions;
+		Frame.Actions = (EReplayInputAction)Actions;
+
+		Ar << Frame.DeltaTime;
+
+		float Pitch = Frame.ControlRotation.Pitch;
+		float Yaw = Frame.ControlRotation.Yaw;
+		Ar << Pitch;
+		Ar << Yaw;
+		Frame.ControlRotation = FRotator(Pitch, Yaw, 0.0f);
+
+		if (Ar.IsError())
+			return;
+
+		Previous = Frame;
+	}
+}
+
+void UInputReplayComponent::CaptureActorStates()
+{
+	ActorStates.Reset();
+
+	UWorld* World = GetWorld();
+	if (!World)
+		return;
+
+	for (TActorIterator<APawn> It(World); It; ++It)
+	{
+		APawn* Pawn = *It;
+		if (Pawn == GetOwner())
+			continue;
+
+		FInputReplayActorState& State = ActorStates.AddDefaulted_GetRef();
+		State.ActorName = Pawn->GetName();
+		State.ClassPath = Pawn->GetClass()->GetPathName();
+		State.Transform = Pawn->GetActorTransform();
+	}
+}
+
+void UInputReplayComponent::RestoreActorStates()
+{
+	UWorld* World = GetWorld();
+	if (!World)
+		return;
+
+	TMap<FString, APawn*> ExistingPawns;
+	for (TActorIterator<APawn> It(World); It; ++It)
+	{
+		ExistingPawns.Add(It->GetName(), *It);
+	}
+
+	int32 SpawnedCount = 0;
+	for (const FInputReplayActorState& State : ActorStates)
+	{
+		if (APawn** Existing = ExistingPawns.Find(State.ActorName))
+		{
+			(*Existing)->SetActorTransform(State.Transform, false, nullptr, ETeleportType::TeleportPhysics);
+			continue;
+		}
+
+		// 录制时存在但当前场景中没有的Pawn：按类重新生成
+		UClass* PawnClass = LoadClass<APawn>(nullptr, *State.ClassPath);
+		if (!PawnClass)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("InputReplay: Cannot restore %s, class %s not found"), *State.ActorName, *State.ClassPath);
+			continue;
+		}
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		if (World->SpawnActor<APawn>(PawnClass, State.Transform, SpawnParams))
+		{
+			++SpawnedCount;
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("InputReplay: Restored %d actors (%d spawned)"), ActorStates.Num(), SpawnedCount);
+}
+
+void UInputReplayComponent::SetControllerTickOrder(bool bTickBeforeController)
+{
+	ClearControllerTickOrder();
+
+	APlayerController* PlayerController = GetOwnerController();
+	if (!PlayerController)
+		return;
+
+	if (bTickBeforeController)
+	{
+		PlayerController->PrimaryActorTick.AddPrerequisite(this, PrimaryComponentTick);
+	}
+	else
+	{
+		PrimaryComponentTick.AddPrerequisite(PlayerController, PlayerController->PrimaryActorTick);
+	}
+	OrderedController = PlayerController;
+}
+
+void UInputReplayComponent::ClearControllerTickOrder()
+{
+	if (APlayerController* PlayerController = OrderedController.Get())
+	{
+		PlayerController->PrimaryActorTick.RemovePrerequisite(this, PrimaryComponentTick);
+		PrimaryComponentTick.RemovePrerequisite(PlayerController, PlayerController->PrimaryActorTick);
+	}
+	OrderedController.Reset();
+}
+
+void UInputReplayComponent::BeginFixedTimeStep(float FixedDeltaTime)
+{
+	bPreviousUseFixedTimeStep = FApp::UseFixedTimeStep();
+	PreviousFixedDeltaTime = FApp::GetFixedDeltaTime();
+	FApp::SetUseFixedTimeStep(true);
+	FApp::SetFixedDeltaTime(FixedDeltaTime);
+}
+
+void UInputReplayComponent::EndFixedTimeStep()
+{
+	FApp::SetUseFixedTimeStep(bPreviousUseFixedTimeStep);
+	FApp::SetFixedDeltaTime(PreviousFixedDeltaTime);
+}
+
+void UInputReplayComponent::FinishPlayback()
+{
+	ClearControllerTickOrder();
+	ReplayState = EInputReplayState::Idle;
+	SetComponentTickEnabled(false);
+
+	EndFixedTimeStep();
+
+	AMyCharacter* Character = GetOwnerCharacter();
+	APlayerController* PlayerController = GetOwnerController();
+	if (Character && PlayerController)
+	{
+		Character->EnableInput(PlayerController);
+	}
+
+	const FRotator FinalRotation = PlayerController ? PlayerController->GetControlRotation() : FRotator::ZeroRotator;
+	const FRotator RecordedFinalRotation = Frames.Num() > 0 ? Frames.Last().ControlRotation : FRotator::ZeroRotator;
+
+	UE_LOG(LogTemp, Warning, TEXT("=== INPUT REPLAY RESULT: %s ==="), *ActiveReplayName);
+	UE_LOG(LogTemp, Warning, TEXT("Frames: %d / %d"), PlaybackFrameIndex, Frames.Num());
+	UE_LOG(LogTemp, Warning, TEXT("Final Rotation: %s (Recorded: %s)"), *FinalRotation.ToString(), *RecordedFinalRotation.ToString());
+	UE_LOG(LogTemp, Warning, TEXT("Max Rotation Divergence: %.4f"), MaxRotationDivergence);
+
+	if (bPrintProfilerReportOnPlaybackEnd)
+	{
+		if (UPerformanceProfiler* Profiler = UPerformanceProfiler::GetPerformanceProfiler(this))
+		{
+			Profiler->PrintPerformanceReport();
+		}
+	}
+
+	if (bExitOnPlaybackEnd)
+	{
+		FPlatformMisc::RequestExit(false);
+	}
+}
+
+AMyCharacter* UInputReplayComponent::GetOwnerCharacter() const
+{
+	return Cast<AMyCharacter>(GetOwner());
+}
+
+APlayerController* UInputReplayComponent::GetOwnerController() const
+{
+	AMyCharacter* Character = GetOwnerCharacter();
+	return Character ? Cast<APlayerController>(Character->GetController()) : nullptr;
+}
@@ -0,0 +1,187 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "InputReplayComponent.generated.h"
+
+class AMyCharacter;
+class APlayerController;
+
+/** 可回放的轴输入 */
+enum class EReplayInputAxis : uint8
+{
+	MoveForward,
+	MoveRight,
+	Turn,
+	LookUp,
+	RightStickX,
+	Count
+};
+
+/** 可回放的按键动作（按位记录） */
+enum class EReplayInputAction : uint8
+{
+	None			= 0,
+	LockOn			= 1 << 0,
+	SwitchLeft		= 1 << 1,
+	SwitchRight		= 1 << 2,
+	JumpPressed		= 1 << 3,
+	JumpReleased	= 1 << 4
+};
+ENUM_CLASS_FLAGS(EReplayInputAction);
+
+/** 单帧输入记录 */
+struct SOUL_API FInputReplayFrame
+{
+	/** 录制时的帧时间 */
+	float DeltaTime = 0.0f;
+
+	/** 本帧各轴的输入值 */
+	float Axes[(int32)EReplayInputAxis::Count] = {};
+
+	/** 本帧触发的按键动作 */
+	EReplayInputAction Actions = EReplayInputAction::None;
+
+	/** 本帧输入处理后的控制器旋转（用于回放时比对） */
+	FRotator ControlRotation = FRotator::ZeroRotator;
+};
+
+/** 录制开始时场景中Pawn的状态 */
+struct SOUL_API FInputReplayActorState
+{
+	FString ActorName;
+	FString ClassPath;
+	FTransform Transform;
+};
+
+UENUM(BlueprintType)
+enum class EInputReplayState : uint8
+{
+	Idle		UMETA(DisplayName = "Idle"),
+	Recording	UMETA(DisplayName = "Recording"),
+	Playing		UMETA(DisplayName = "Playing")
+};
+
+/**
+ * 确定性输入与相机回放组件
+ * 录制每帧的移动/视角/锁定输入、帧时间、随机种子以及场景中Pawn的初始状态，保存为紧凑的二进制文件；
+ * 回放时以固定步长把输入重新喂给AMyCharacter，并与录制时的相机旋转比对，便于在不同版本间对比性能与结果。
+ *
+ * 控制台：Soul.Replay.Record [名称] / Soul.Replay.Play [名称] / Soul.Replay.Stop
+ * 无界面回放：-nullrhi -SoulReplay=<名称> [-SoulReplayExit]
+ */
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class SOUL_API UInputReplayComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UInputReplayComponent();
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+public:
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	// ==================== 录制与回放 ====================
+
+	/** 开始录制（名称为空时使用时间戳） */
+	UFUNCTION(BlueprintCallable, Category = "Input Replay")
+	bool StartRecording(const FString& ReplayName);
+
+	/** 开始回放指定录像 */
+	UFUNCTION(BlueprintCallable, Category = "Input Replay")
+	bool StartPlayback(const FString& ReplayName);
+
+	/** 停止录制（写入文件）或停止回放（输出比对结果） */
+	UFUNCTION(BlueprintCallable, Category = "Input Replay")
+	void Stop();
+
+	UFUNCTION(BlueprintCallable, Category = "Input Replay")
+	EInputReplayState GetReplayState() const { return ReplayState; }
+
+	/** 录制一帧中的轴输入（由角色的输入处理函数调用） */
+	void RecordAxis(EReplayInputAxis Axis, float Value);
+
+	/** 录制一帧中的按键动作（由角色的输入处理函数调用） */
+	void RecordAction(EReplayInputAction Action);
+
+	/** 录像文件的完整路径 */
+	static FString GetReplayFilePath(const FString& ReplayName);
+
+	// ==================== 配置 ====================
+
+	/** 录制时使用的固定帧时间（回放按录像中每帧记录的帧时间推进） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Input Replay", meta = (ClampMin = "0.001", ClampMax = "0.1"))
+	float PlaybackFixedDeltaTime = 1.0f / 60.0f;
+
+	/** 回放结束时是否输出性能分析报告 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Input Replay")
+	bool bPrintProfilerReportOnPlaybackEnd = true;
+
+private:
+	/** 录像文件格式 */
+	static constexpr uint32 REPLAY_MAGIC = 0x4C505253; // 'SRPL'
+	static constexpr uint32 REPLAY_VERSION = 1;
+
+	/** 序列化录像（轴输入只写与上一帧不同的值） */
+	void SerializeReplay(FArchive& Ar);
+
+	/** 记录/恢复场景中Pawn的状态 */
+	void CaptureActorStates();
+	void RestoreActorStates();
+
+	/** 调整与玩家控制器的Tick先后顺序：录制在输入处理之后，回放在输入处理之前 */
+	void SetControllerTickOrder(bool bTickBeforeController);
+	void ClearControllerTickOrder();
+
+	void FinishPlayback();
+
+	/** 切换到固定步长（保存原设置）/恢复原设置 */
+	void BeginFixedTimeStep(float FixedDeltaTime);
+	void EndFixedTimeStep();
+
+	AMyCharacter* GetOwnerCharacter() const;
+	APlayerController* GetOwnerController() const;
+
+	EInputReplayState ReplayState = EInputReplayState::Idle;
+
+	FString ActiveReplayName;
+
+	/** 随机种子（录制开始时生成，回放时复用） */
+	int32 RandomSeed = 0;
+
+	/** 录制开始时的玩家状态 */
+	FTransform StartTransform;
+	FRotator StartControlRotation = FRotator::ZeroRotator;
+
+	TArray<FInputReplayActorState> ActorStates;
+
+	TArray<FInputReplayFrame> Frames;
+
+	/** 录制中尚未提交的当前帧 */
+	FInputReplayFrame PendingFrame;
+
+	/** 回放进度 */
+	int32 PlaybackFrameIndex = 0;
+
+	/** 回放与录制的相机旋转最大偏差 */
+	float MaxRotationDivergence = 0.0f;
+
+	/** 录制/回放前的固定步长设置（结束后恢复） */
+	bool bPreviousUseFixedTimeStep = false;
+	double PreviousFixedDeltaTime = 0.0;
+
+	/** 调整了Tick顺序的控制器 */
+	TWeakObjectPtr<APlayerController> OrderedController;
+
+	/** 命令行指定、等待控制器就绪后启动的录像 */
+	FString CommandLineReplayName;
+
+	/** 回放结束后退出程序（命令行 -SoulReplayExit） */
+	bool bExitOnPlaybackEnd = false;
+};
@@ -0,0 +1,149 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "LockOnCandidateSubsystem.h"
+#include "TargetDetectionComponent.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "EngineUtils.h"
+#include "SoulTrace.h"
+
+void ULockOnCandidateSubsystem::RegisterDetector(UTargetDetectionComponent* Detector)
+{
+	if (Detector)
+	{
+		Detectors.AddUnique(Detector);
+	}
+}
+
+void ULockOnCandidateSubsystem::UnregisterDetector(UTargetDetectionComponent* Detector)
+{
+	Detectors.RemoveSwap(Detector);
+}
+
+int32 ULockOnCandidateSubsystem::GetNumLocalDetectors() const
+{
+	int32 NumLocal = 0;
+	for (const TWeakObjectPtr<UTargetDetectionComponent>& Detector : Detectors)
+	{
+		if (IsLocalDetector(Detector.Get()))
+		{
+			++NumLocal;
+		}
+	}
+	return NumLocal;
+}
+
+bool ULockOnCandidateSubsystem::IsLocalDetector(const UTargetDetectionComponent* Detector)
+{
+	// 监听服务器上的远端玩家与AI也会注册组件，只有本地玩家控制器拥有的才算
+	const APawn* OwnerPawn = Detector ? Cast<APawn>(Detector->GetOwner()) : nullptr;
+	const APlayerController* PlayerController = OwnerPawn ? Cast<APlayerController>(OwnerPawn->GetController()) : nullptr;
+	return PlayerController && PlayerController->IsLocalController();
+}
+
+void ULockOnCandidateSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// 计数器是全局的：合计所有检测组件（各玩家与AI）后每帧只设置一次
+	int32 TotalCandidates = 0;
+	int32 TotalTraces = 0;
+	for (const TWeakObjectPtr<UTargetDetectionComponent>& WeakDetector : Detectors)
+	{
+		if (UTargetDetectionComponent* Detector = WeakDetector.Get())
+		{
+			TotalCandidates += Detector->GetLockOnCandidates().Num();
+			TotalTraces += Detector->ConsumeTraceCount();
+		}
+	}
+
+	SOUL_TRACE_COUNTER_SET(SoulLockOn_Candidates, TotalCandidates);
+	SOUL_TRACE_COUNTER_SET(SoulLockOn_TracesIssued, TotalTraces);
+}
+
+TStatId ULockOnCandidateSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(ULockOnCandidateSubsystem, STATGROUP_Tickables);
+}
+
+bool ULockOnCandidateSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+const TArray<FSharedLockOnCandidate>& ULockOnCandidateSubsystem::GetCandidates()
+{
+	if (GatheredFrame != GFrameCounter)
+	{
+		GatherCandidates();
+		GatheredFrame = GFrameCounter;
+	}
+	return Candidates;
+}
+
+const FSharedLockOnCandidate* ULockOnCandidateSubsystem::FindCandidate(const AActor* Actor)
+{
+	GetCandidates();
+
+	const int32* Index = CandidateIndices.Find(TObjectKey<AActor>(Actor));
+	return Index ? &Candidates[*Index] : nullptr;
+}
+
+void ULockOnCandidateSubsystem::GatherCandidates()
+{
+	Candidates.Reset();
+	CandidateIndices.Reset();
+
+	// 清理失效的组件，记录每个本地玩家的位置与锁定范围
+	ViewerScratch.Reset();
+	for (int32 Index = Detectors.Num() - 1; Index >= 0; --Index)
+	{
+		UTargetDetectionComponent* Detector = Detectors[Index].Get();
+		if (!Detector)
+		{
+			Detectors.RemoveAtSwap(Index);
+			continue;
+		}
+
+		if (!IsLocalDetector(Detector))
+			continue;
+
+		if (const AActor* Owner = Detector->GetOwner())
+		{
+			ViewerScratch.Emplace(Owner->GetActorLocation(), Detector->GetCompiledSettings().LockOnRangeSquared);
+		}
+	}
+
+	if (ViewerScratch.Num() == 0)
+		return;
+
+	for (TActorIterator<APawn> It(GetWorld()); It; ++It)
+	{
+		APawn* Pawn = *It;
+		if (!UTargetDetectionComponent::IsLockableActor(Pawn))
+			continue;
+
+		const FVector Location = Pawn->GetActorLocation();
+		bool bInAnyRange = false;
+		for (const TPair<FVector, float>& Viewer : ViewerScratch)
+		{
+			if (FVector::DistSquared(Viewer.Key, Location) <= Viewer.Value)
+			{
+				bInAnyRange = true;
+				break;
+			}
+		}
+		if (!bInAnyRange)
+			continue;
+
+		// 包围盒需要遍历组件，每个目标每帧只算一次
+		FVector BoxExtent;
+		FSharedLockOnCandidate& Candidate = Candidates.AddDefaulted_GetRef();
+		Candidate.Actor = Pawn;
+		Candidate.Location = Location;
+		Pawn->GetActorBounds(false, Candidate.BoundsOrigin, BoxExtent);
+		Candidate.BoundsSize = FMath::Max3(BoxExtent.X, BoxExtent.Y, BoxExtent.Z) * 2.0f;
+
+		CandidateIndices.Add(TObjectKey<AActor>(Pawn), Candidates.Num() - 1);
+	}
+}
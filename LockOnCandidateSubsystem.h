@@ -0,0 +1,79 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "LockOnCandidateSubsystem.generated.h"
+
+class UTargetDetectionComponent;
+
+/** 与视角无关、所有玩家共享的候选数据 */
+struct SOUL_API FSharedLockOnCandidate
+{
+	TWeakObjectPtr<AActor> Actor;
+
+	/** 收集时的Actor位置 */
+	FVector Location = FVector::ZeroVector;
+
+	/** 包围盒中心与最大边长（尺寸分类的输入） */
+	FVector BoundsOrigin = FVector::ZeroVector;
+	float BoundsSize = 0.0f;
+};
+
+/**
+ * 共享锁定候选子系统
+ * 分屏时每个玩家的目标检测组件原本各自做球体重叠、有效性判断与包围盒计算，同一个敌人被处理多次。
+ * 本子系统每帧最多收集一次：遍历一次场景中的Pawn，只保留落在任一注册玩家锁定范围内的可锁定目标，
+ * 并计算一次包围盒；各玩家的组件只在这份共享集合上做视线检测与依赖视角的评分。
+ * 只有一个玩家注册时组件仍使用自己的球体重叠（由物理增量维护，开销更低）。
+ * 每帧汇总所有注册组件的候选数与视线检测数，统一设置一次SoulLockOn追踪计数器。
+ */
+UCLASS()
+class SOUL_API ULockOnCandidateSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** 注册/注销目标检测组件（BeginPlay/EndPlay调用） */
+	void RegisterDetector(UTargetDetectionComponent* Detector);
+	void UnregisterDetector(UTargetDetectionComponent* Detector);
+
+	/** 注册的检测组件数（包括远端玩家与AI拥有的组件） */
+	int32 GetNumDetectors() const { return Detectors.Num(); }
+
+	/** 由本地玩家控制器拥有的检测组件数（多于一个即分屏，共享收集才有收益） */
+	int32 GetNumLocalDetectors() const;
+
+	/** 检测组件是否属于本地玩家（只有本地玩家的组件使用共享候选） */
+	static bool IsLocalDetector(const UTargetDetectionComponent* Detector);
+
+	/** 本帧的共享候选（每帧第一次调用时收集） */
+	const TArray<FSharedLockOnCandidate>& GetCandidates();
+
+	/** 查找本帧某个目标的共享数据 */
+	const FSharedLockOnCandidate* FindCandidate(const AActor* Actor);
+
+	// UTickableWorldSubsystem
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** 遍历场景中的Pawn，重建共享候选 */
+	void GatherCandidates();
+
+	TArray<TWeakObjectPtr<UTargetDetectionComponent>> Detectors;
+
+	TArray<FSharedLockOnCandidate> Candidates;
+	TMap<TObjectKey<AActor>, int32> CandidateIndices;
+
+	/** 收集时每个本地玩家的位置与锁定范围平方（复用） */
+	TArray<TPair<FVector, float>> ViewerScratch;
+
+	/** 最近一次收集的帧号 */
+	uint64 GatheredFrame = MAX_uint64;
+};
@@ -84,6 +84,26 @@ struct SOUL_API FCameraTypeConfig
 	float SwitchSpeed;
 };
 
+/**
+ * Fully resolved camera profile of one enemy
+ * Built once when the enemy's camera config begins play or is edited, so the camera
+ * never reclassifies the target or merges overrides while locked on.
+ */
+struct SOUL_API FResolvedEnemyCameraProfile
+{
+	/** Camera behaviour type */
+	EEnemyCameraType CameraType = EEnemyCameraType::Medium;
+
+	/** Size category used for lock-on height offsets */
+	EEnemySizeCategory SizeCategory = EEnemySizeCategory::Medium;
+
+	/** Type defaults with custom overrides already applied */
+	FCameraTypeConfig Config;
+
+	/** False until the profile has been resolved */
+	bool bIsResolved = false;
+};
+
 /**
  * Lock-on system configuration settings
  */
@@ -367,4 +387,70 @@ struct SOUL_API FSocketProjectionSettings
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Socket Projection")
 	TArray<FName> SocketSearchNames;
 
-};
\ No newline at end of file
+};
+
+/**
+ * Immutable compiled form of the lock-on and camera settings
+ * Built once from the editable config structs and shared by every component of a character,
+ * so hot paths compare dot products and squared distances instead of converting angles or taking square roots.
+ * Rebuild it (Build) whenever the source settings change; never mutate a shared instance.
+ */
+struct SOUL_API FCompiledLockOnSettings
+{
+	/** Number of entries in the distance score lookup table */
+	static constexpr int32 DISTANCE_SCORE_LUT_SIZE = 64;
+
+	/** Source settings this instance was compiled from */
+	FLockOnSettings LockOn;
+	FCameraSettings Camera;
+	FAdvancedCameraSettings Advanced;
+
+	/** Cosines of the half-angles (compare against dot(CameraForward, ToTarget)) */
+	float LockOnHalfAngleCos = 0.0f;
+	float SectorHalfAngleCos = 0.0f;
+	float EdgeHalfAngleCos = 0.0f;
+
+	/** Squared ranges (compare against FVector::DistSquared) */
+	float LockOnRangeSquared = 0.0f;
+	float ExtendedLockOnRangeSquared = 0.0f;
+
+	/** Reciprocal lock-on range (0 if the range is invalid) */
+	float InvLockOnRange = 0.0f;
+
+	/** Distance score term 1 - sqrt(Distance / LockOnRange), sampled over [0, 2 * LockOnRange] to cover the extended range */
+	float DistanceScoreLUT[DISTANCE_SCORE_LUT_SIZE + 1];
+
+	/** Build a new shared instance from the editable settings */
+	static TSharedRef<const FCompiledLockOnSettings> Build(const FLockOnSettings& InLockOn, const FCameraSettings& InCamera, const FAdvancedCameraSettings& InAdvanced)
+	{
+		TSharedRef<FCompiledLockOnSettings> Compiled = MakeShared<FCompiledLockOnSettings>();
+		Compiled->LockOn = InLockOn;
+		Compiled->Camera = InCamera;
+		Compiled->Advanced = InAdvanced;
+
+		Compiled->LockOnHalfAngleCos = FMath::Cos(FMath::DegreesToRadians(InLockOn.LockOnAngle * 0.5f));
+		Compiled->SectorHalfAngleCos = FMath::Cos(FMath::DegreesToRadians(InLockOn.SectorLockAngle * 0.5f));
+		Compiled->EdgeHalfAngleCos = FMath::Cos(FMath::DegreesToRadians(InLockOn.EdgeDetectionAngle * 0.5f));
+
+		const float ExtendedRange = InLockOn.LockOnRange * InLockOn.ExtendedLockRangeMultiplier;
+		Compiled->LockOnRangeSquared = FMath::Square(InLockOn.LockOnRange);
+		Compiled->ExtendedLockOnRangeSquared = FMath::Square(ExtendedRange);
+		Compiled->InvLockOnRange = InLockOn.LockOnRange > 0.0f ? 1.0f / InLockOn.LockOnRange : 0.0f;
+
+		for (int32 Index = 0; Index <= DISTANCE_SCORE_LUT_SIZE; ++Index)
+		{
+			const float NormalizedDistance = 2.0f * Index / DISTANCE_SCORE_LUT_SIZE;
+			Compiled->DistanceScoreLUT[Index] = 1.0f - FMath::Sqrt(NormalizedDistance);
+		}
+
+		return Compiled;
+	}
+
+	/** Distance score term for a raw distance (linear interpolation in the lookup table) */
+	float GetDistanceScore(float Distance) const
+	{
+		const float Position = FMath::Clamp(Distance * InvLockOnRange, 0.0f, 2.0f) * (DISTANCE_SCORE_LUT_SIZE / 2);
+		const int32 Index = FMath::Min(FMath::FloorToInt(Position), DISTANCE_SCORE_LUT_SIZE - 1);
+		return FMath::Lerp(DistanceScoreLUT[Index], DistanceScoreLUT[Index + 1], Position - Index);
+	}
+};
@@ -0,0 +1,79 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "LockOnReplication.h"
+#include "MyCharacter.h"
+#include "DebugManager.h"
+#include "GameFramework/Actor.h"
+#include "UObject/CoreNet.h"
+#include "Engine/World.h"
+#include "UObject/UObjectIterator.h"
+
+void FReplicatedLockOnState::SetCameraRotation(const FRotator& Rotation)
+{
+	PackedYaw = FRotator::CompressAxisToShort(Rotation.Yaw);
+	PackedPitch = FRotator::CompressAxisToByte(Rotation.Pitch);
+}
+
+FRotator FReplicatedLockOnState::GetCameraRotation() const
+{
+	return FRotator(
+		FRotator::NormalizeAxis(FRotator::DecompressAxisFromByte(PackedPitch)),
+		FRotator::NormalizeAxis(FRotator::DecompressAxisFromShort(PackedYaw)),
+		0.0f);
+}
+
+bool FReplicatedLockOnState::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	bOutSuccess = true;
+
+	uint8 bHasTarget = Target != nullptr ? 1 : 0;
+	Ar.SerializeBits(&bHasTarget, 1);
+
+	if (bHasTarget)
+	{
+		UObject* TargetObject = Target;
+		bOutSuccess &= Map ? Map->SerializeObject(Ar, AActor::StaticClass(), TargetObject) : false;
+		if (Ar.IsLoading())
+		{
+			Target = Cast<AActor>(TargetObject);
+		}
+	}
+	else if (Ar.IsLoading())
+	{
+		Target = nullptr;
+	}
+
+	Ar << SwitchSequence;
+	Ar << PackedYaw;
+	Ar << PackedPitch;
+
+	return true;
+}
+
+// ==================== 控制台命令 ====================
+
+static FAutoConsoleCommand CmdSoulLockOnNetStatus(
+	TEXT("Soul.LockOn.NetStatus"),
+	TEXT("Print the local and replicated lock-on state of every character (use in each PIE window of a listen-server session)"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		for (TObjectIterator<AMyCharacter> It; It; ++It)
+		{
+			AMyCharacter* Character = *It;
+			UWorld* World = Character->GetWorld();
+			if (!World || !World->IsGameWorld() || Character->IsTemplate())
+				continue;
+
+			const FReplicatedLockOnState& State = Character->GetReplicatedLockOnState();
+			const FRotator Camera = State.GetCameraRotation();
+			UE_LOG(LogSoul, Warning, TEXT("[%s] %s (%s): Local=%s Replicated=%s Seq=%u Camera=(P=%.1f Y=%.1f)"),
+				World->GetNetMode() == NM_Client ? TEXT("Client") : TEXT("Server"),
+				*Character->GetName(),
+				*UEnum::GetValueAsString(Character->GetLocalRole()),
+				Character->GetLockOnTarget() ? *Character->GetLockOnTarget()->GetName() : TEXT("None"),
+				State.Target ? *State.Target->GetName() : TEXT("None"),
+				State.SwitchSequence,
+				Camera.Pitch, Camera.Yaw);
+		}
+	})
+);
@@ -0,0 +1,77 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LockOnReplication.generated.h"
+
+class AActor;
+class UPackageMap;
+
+/**
+ * 复制用的紧凑锁定状态
+ * 自定义网络序列化：1位是否锁定 + 目标的Net GUID + 8位切换序号 + 16位相机偏航 + 8位相机俯仰，
+ * 通常不超过6字节。只在变化时发送（推送模型），相机朝向按量化后的值比较。
+ */
+USTRUCT(BlueprintType)
+struct SOUL_API FReplicatedLockOnState
+{
+	GENERATED_BODY()
+
+	/** 锁定的目标（序列化为Net GUID） */
+	UPROPERTY(BlueprintReadOnly, Category = "LockOn|Network")
+	AActor* Target = nullptr;
+
+	/** 每次目标变化递增（回绕），用于对齐预测与服务器确认 */
+	UPROPERTY(BlueprintReadOnly, Category = "LockOn|Network")
+	uint8 SwitchSequence = 0;
+
+	/** 量化的相机朝向 */
+	UPROPERTY()
+	uint16 PackedYaw = 0;
+
+	UPROPERTY()
+	uint8 PackedPitch = 0;
+
+	bool IsLockedOn() const { return Target != nullptr; }
+
+	/** 量化并写入相机朝向 */
+	void SetCameraRotation(const FRotator& Rotation);
+
+	/** 解码相机朝向（俯仰精度约1.4度） */
+	FRotator GetCameraRotation() const;
+
+	/** 相机朝向的量化值是否相同 */
+	bool HasSameCamera(const FReplicatedLockOnState& Other) const
+	{
+		return PackedYaw == Other.PackedYaw && PackedPitch == Other.PackedPitch;
+	}
+
+	/** 序号a是否比b新（考虑回绕） */
+	static bool IsNewerSequence(uint8 A, uint8 B)
+	{
+		return (int8)(A - B) > 0;
+	}
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+
+	bool operator==(const FReplicatedLockOnState& Other) const
+	{
+		return Target == Other.Target && SwitchSequence == Other.SwitchSequence && HasSameCamera(Other);
+	}
+
+	bool operator!=(const FReplicatedLockOnState& Other) const
+	{
+		return !(*this == Other);
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FReplicatedLockOnState> : public TStructOpsTypeTraitsBase2<FReplicatedLockOnState>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true
+	};
+};
@@ -15,9 +15,13 @@
 #include "EngineUtils.h"
 #include "TimerManager.h"
 #include "Components/SkeletalMeshComponent.h"
+#include "SocketResolutionCache.h"
 #include "UObject/UObjectGlobals.h"
 #include "Engine/Engine.h"
 #include "UObject/StructOnScope.h"
+#include "DebugManager.h"
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
 
 // Sets default values
 AMyCharacter::AMyCharacter()
@@ -46,6 +50,9 @@ AMyCharacter::AMyCharacter()
 	DodgeComponent = CreateDefaultSubobject<UDodgeComponent>(TEXT("DodgeComponent"));
 	ExecutionComponent = CreateDefaultSubobject<UExecutionComponent>(TEXT("ExecutionComponent"));
 
+	// ==================== 创建输入回放组件 ====================
+	InputReplayComponent = CreateDefaultSubobject<UInputReplayComponent>(TEXT("InputReplayComponent"));
+
 	// ==================== 创建锁定检测球体组件 ====================
 	// 原始代码注释保留：此组件用于检测可锁定的敌人
 	LockOnDetectionSphere = CreateDefaultSubobject<USphereComponent>(TEXT("LockOnDetectionSphere"));
@@ -183,6 +190,16 @@ void AMyCharacter::BeginPlay()
 	// 验证并缓存组件
 	ValidateAndCacheComponents();
 	
+	// 相机设置变更时重建编译后的共享锁定设置
+	if (CameraControlComponent)
+	{
+		CameraControlComponent->OnCameraSettingsChanged.AddUObject(this, &AMyCharacter::RebuildCompiledLockOnSettings);
+	}
+	if (TargetDetectionComponent)
+	{
+		TargetDetectionComponent->OnLockOnSettingsChanged.AddUObject(this, &AMyCharacter::RebuildCompiledLockOnSettings);
+	}
+	
 	// ==================== 步骤2：如果找到组件，应用初始配置 ====================
 	if (CameraBoom && FollowCamera)
 	{
@@ -310,14 +327,12 @@ void AMyCharacter::BeginPlay()
 		TargetDetectionComponent->SetLockOnDetectionSphere(LockOnDetectionSphere);
 		
 		// ������������
-		TargetDetectionComponent->LockOnSettings.LockOnRange = LockOnRange;
-		TargetDetectionComponent->LockOnSettings.LockOnAngle = LockOnAngle;
+		FLockOnSettings LockOnSetup = TargetDetectionComponent->LockOnSettings;
+		LockOnSetup.LockOnRange = LockOnRange;
+		LockOnSetup.LockOnAngle = LockOnAngle;
+		TargetDetectionComponent->SetLockOnSettings(LockOnSetup);
 		
-		// �����������
-		TargetDetectionComponent->CameraSettings.CameraInterpSpeed = CameraInterpSpeed;
-		TargetDetectionComponent->CameraSettings.bEnableSmoothCameraTracking = bEnableSmoothCameraTracking;
-		TargetDetectionComponent->CameraSettings.CameraTrackingMode = CameraTrackingMode;
-		TargetDetectionComponent->CameraSettings.TargetLocationOffset = TargetLocationOffset;
+		// 相机参数统一由CameraControlComponent提供（见下方），编译后分发给目标检测组件
 		
 		// ����SocketͶ�����
 		TargetDetectionComponent->SocketProjectionSettings.bUseSocketProjection = bUseSocketProjection;
@@ -379,6 +394,9 @@ void AMyCharacter::BeginPlay()
 		UE_LOG(LogTemp, Error, TEXT("MyCharacter: UIManagerComponent is null!"));
 	}
 
+	// ==================== 构建并分发编译后的共享锁定设置 ====================
+	RebuildCompiledLockOnSettings();
+
 	// ==================== 验证所有核心组件实际已经挂载，功能检查） ====================
 	if (PoiseComponent)
 	{
@@ -417,12 +435,12 @@ void AMyCharacter::BeginPlay()
 	if (CameraDebugComponent)
 	{
 #if WITH_EDITOR
-		// 编辑器中默认开启Debug
-		CameraDebugComponent->bEnableDebugVisualization = true;
-		CameraDebugComponent->VisualizationMode = EDebugVisualizationMode::TargetInfo;
+		// 编辑器中默认开启Debug（组件的BeginPlay先于这里执行，通过setter按最终设置刷新Tick状态）
+		CameraDebugComponent->SetVisualizationMode(EDebugVisualizationMode::TargetInfo);
+		CameraDebugComponent->SetDebugVisualizationEnabled(true);
 #else
 		// 发布版本默认关闭
-		CameraDebugComponent->bEnableDebugVisualization = false;
+		CameraDebugComponent->SetDebugVisualizationEnabled(false);
 #endif
 		
 		UE_LOG(LogTemp, Warning, TEXT("MyCharacter: CameraDebugComponent configured"));
@@ -438,6 +456,21 @@ void AMyCharacter::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
+	// 锁定期间维持闪避方向安全图，按下闪避时直接读取
+	if (DodgeComponent)
+	{
+		DodgeComponent->SetSafetyMapActive(bIsLockedOn);
+	}
+
+	// 本地锁定状态变化时发布给服务器（先于可能提前返回的相机逻辑）
+	UpdateLockOnReplication(DeltaTime);
+
+	// 锁定目标及其相邻候选按最高重要度刷新
+	if (TargetDetectionComponent)
+	{
+		TargetDetectionComponent->SetFocusTarget(CurrentLockOnTarget);
+	}
+
 	// ����ƽ��������ã����ȼ���ߣ���Ϊ�Ƿ�����״̬��
 	if (bIsSmoothCameraReset)
 	{
@@ -473,16 +506,10 @@ void AMyCharacter::Tick(float DeltaTime)
 		// ���������Ϣ���ɿ����ƣ�- ���ӽ�Ƶ����
 		if (bEnableCameraDebugLogs && CurrentLockOnTarget)
 		{
-			static float LastCameraDebugLogTime = 0.0f;
-			float CurrentTime = GetWorld()->GetTimeSeconds();
-			if (CurrentTime - LastCameraDebugLogTime > 0.5f) // ÿ0.5���¼һ��
-			{
-				UE_LOG(LogTemp, VeryVerbose, TEXT("LockOn Active: Target=%s, CameraFollow=%s, CharacterRotate=%s"), 
-					*CurrentLockOnTarget->GetName(),
-					bShouldCameraFollowTarget ? TEXT("YES") : TEXT("NO"),
-					bShouldCharacterRotateToTarget ? TEXT("YES") : TEXT("NO"));
-				LastCameraDebugLogTime = CurrentTime;
-			}
+			SOUL_LOG_VERY_VERBOSE_RATE_LIMITED(Camera, 0.5, TEXT("LockOn Active: Target=%s, CameraFollow=%s, CharacterRotate=%s"), 
+				*CurrentLockOnTarget->GetName(),
+				bShouldCameraFollowTarget ? TEXT("YES") : TEXT("NO"),
+				bShouldCharacterRotateToTarget ? TEXT("YES") : TEXT("NO"));
 		}
 	}
 
@@ -493,18 +520,21 @@ void AMyCharacter::Tick(float DeltaTime)
 		float CurrentTime = GetWorld()->GetTimeSeconds();
 		if (CurrentTime - LastFindTargetsTime > TARGET_SEARCH_INTERVAL)
 		{
-			FindLockOnCandidates();
+			// 异步评分开启时直接取组件最近发布的结果，否则同步刷新
+			if (TargetDetectionComponent && TargetDetectionComponent->IsAsyncTargetScoringEnabled())
+			{
+				LockOnCandidates = TargetDetectionComponent->GetLockOnCandidates();
+			}
+			else
+			{
+				FindLockOnCandidates();
+			}
 			LastFindTargetsTime = CurrentTime;
 
 			// ����������Ϣ���ɿ��ƣ�- ���ӽ�Ƶ����
 			if (bEnableLockOnDebugLogs)
 			{
-				static float LastTargetSearchLogTime = 0.0f;
-				if (CurrentTime - LastTargetSearchLogTime > 1.0f) // ÿ1���¼һ��
-				{
-					UE_LOG(LogTemp, Verbose, TEXT("Target search completed: Found %d candidates"), LockOnCandidates.Num());
-					LastTargetSearchLogTime = CurrentTime;
-				}
+				SOUL_LOG_VERBOSE_RATE_LIMITED(LockOn, 1.0, TEXT("Target search completed: Found %d candidates"), LockOnCandidates.Num());
 			}
 		}
 	}
@@ -579,8 +609,8 @@ void AMyCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputCompone
 	PlayerInputComponent->BindAxis("RightStickX", this, &AMyCharacter::HandleRightStickX);
 	
 	// �������Ҽ�ͷ�ل�Ŀ��
-	PlayerInputComponent->BindAction("SwitchTargetLeft", IE_Pressed, this, &AMyCharacter::SwitchLockOnTargetLeft);
-	PlayerInputComponent->BindAction("SwitchTargetRight", IE_Pressed, this, &AMyCharacter::SwitchLockOnTargetRight);
+	PlayerInputComponent->BindAction("SwitchTargetLeft", IE_Pressed, this, &AMyCharacter::HandleSwitchTargetLeftButton);
+	PlayerInputComponent->BindAction("SwitchTargetRight", IE_Pressed, this, &AMyCharacter::HandleSwitchTargetRightButton);
 
 	// ==================== ��������� ====================
 	// ���ӵ��԰�key (F��) ����������
@@ -599,6 +629,11 @@ void AMyCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputCompone
 // ==================== �ƶ�����ʵ�� ====================
 void AMyCharacter::MoveForward(float Value)
 {
+	if (InputReplayComponent)
+	{
+		InputReplayComponent->RecordAxis(EReplayInputAxis::MoveForward, Value);
+	}
+
 	ForwardInputValue = Value;
 
 	// �ȴ��������������ƶ�����
@@ -660,6 +695,11 @@ void AMyCharacter::MoveForward(float Value)
 
 void AMyCharacter::MoveRight(float Value)
 {
+	if (InputReplayComponent)
+	{
+		InputReplayComponent->RecordAxis(EReplayInputAxis::MoveRight, Value);
+	}
+
 	RightInputValue = Value;
 
 	// �ȴ��������������ƶ�����
@@ -721,17 +761,30 @@ void AMyCharacter::MoveRight(float Value)
 
 void AMyCharacter::StartJump()
 {
+	if (InputReplayComponent)
+	{
+		InputReplayComponent->RecordAction(EReplayInputAction::JumpPressed);
+	}
 	Jump();
 }
 
 void AMyCharacter::StopJump()
 {
+	if (InputReplayComponent)
+	{
+		InputReplayComponent->RecordAction(EReplayInputAction::JumpReleased);
+	}
 	StopJumping();
 }
 
 // ==================== ������� ====================
 void AMyCharacter::Turn(float Rate)
 {
+	if (InputReplayComponent)
+	{
+		InputReplayComponent->RecordAxis(EReplayInputAxis::Turn, Rate);
+	}
+
 	// �ȴ�����������������
 	if (CameraControlComponent)
 	{
@@ -797,6 +850,11 @@ void AMyCharacter::Turn(float Rate)
 
 void AMyCharacter::LookUp(float Rate)
 {
+	if (InputReplayComponent)
+	{
+		InputReplayComponent->RecordAxis(EReplayInputAxis::LookUp, Rate);
+	}
+
 	// �ȴ�����������������
 	if (CameraControlComponent)
 	{
@@ -1367,6 +1425,11 @@ void AMyCharacter::UpdateSmoothTargetSwitch()
 // ==================== ���봦������ ====================
 void AMyCharacter::HandleRightStickX(float Value)
 {
+	if (InputReplayComponent)
+	{
+		InputReplayComponent->RecordAxis(EReplayInputAxis::RightStickX, Value);
+	}
+
 	// ֻ������״̬�´�����ق���ل�Ŀ��
 	if (!bIsLockedOn)
 		return;
@@ -1391,67 +1454,103 @@ void AMyCharacter::HandleRightStickX(float Value)
 
 void AMyCharacter::HandleLockOnButton()
 {
+	if (InputReplayComponent)
+	{
+		InputReplayComponent->RecordAction(EReplayInputAction::LockOn);
+	}
+
 	ToggleLockOn();
 }
 
-void AMyCharacter::SwitchLockOnTargetLeft()
+void AMyCharacter::HandleSwitchTargetLeftButton()
 {
-	if (!bIsLockedOn || LockOnCandidates.Num() <= 1)
-		return;
+	if (InputReplayComponent)
+	{
+		InputReplayComponent->RecordAction(EReplayInputAction::SwitchLeft);
+	}
 
-	// �л�ǰ��ǿ����������UI��ȷ��û������
-	HideAllLockOnWidgets();
+	SwitchLockOnTargetLeft();
+}
 
-	// ֻ�ڱ�Ҫʱˢ�º�ѡĿ���б�
-	if (LockOnCandidates.Num() == 0)
+void AMyCharacter::HandleSwitchTargetRightButton()
+{
+	if (InputReplayComponent)
 	{
-		FindLockOnCandidates();
+		InputReplayComponent->RecordAction(EReplayInputAction::SwitchRight);
 	}
 
-	int32 CurrentIndex = LockOnCandidates.Find(CurrentLockOnTarget);
-	if (CurrentIndex != INDEX_NONE && CurrentIndex > 0)
+	SwitchLockOnTargetRight();
+}
+
+void AMyCharacter::ApplyReplayFrame(const FInputReplayFrame& Frame)
+{
+	// 与输入组件一致：先处理按键动作，再按绑定顺序处理轴输入
+	if (EnumHasAnyFlags(Frame.Actions, EReplayInputAction::JumpPressed))
 	{
-		int32 NewIndex = CurrentIndex - 1;
-		AActor* NewTarget = LockOnCandidates[NewIndex];
-		
-		if (IsValidLockOnTarget(NewTarget))
-		{
-			PreviousLockOnTarget = CurrentLockOnTarget;
-			CurrentLockOnTarget = NewTarget;
-			StartSmoothTargetSwitch(NewTarget);
-			ShowLockOnWidget();
-		}
+		StartJump();
+	}
+	if (EnumHasAnyFlags(Frame.Actions, EReplayInputAction::JumpReleased))
+	{
+		StopJump();
+	}
+	if (EnumHasAnyFlags(Frame.Actions, EReplayInputAction::LockOn))
+	{
+		HandleLockOnButton();
+	}
+	if (EnumHasAnyFlags(Frame.Actions, EReplayInputAction::SwitchLeft))
+	{
+		SwitchLockOnTargetLeft();
+	}
+	if (EnumHasAnyFlags(Frame.Actions, EReplayInputAction::SwitchRight))
+	{
+		SwitchLockOnTargetRight();
 	}
+
+	MoveForward(Frame.Axes[(int32)EReplayInputAxis::MoveForward]);
+	MoveRight(Frame.Axes[(int32)EReplayInputAxis::MoveRight]);
+	Turn(Frame.Axes[(int32)EReplayInputAxis::Turn]);
+	LookUp(Frame.Axes[(int32)EReplayInputAxis::LookUp]);
+	HandleRightStickX(Frame.Axes[(int32)EReplayInputAxis::RightStickX]);
 }
 
-void AMyCharacter::SwitchLockOnTargetRight()
+void AMyCharacter::SwitchLockOnTargetLeft()
 {
-	if (!bIsLockedOn || LockOnCandidates.Num() <= 1)
+	if (!bIsLockedOn || !TargetDetectionComponent)
+		return;
+
+	// 切换目标由检测组件随每次搜索预先算好，输入当帧直接开始切换
+	AActor* NewTarget = TargetDetectionComponent->GetLeftSwitchTarget();
+	if (!NewTarget || NewTarget == CurrentLockOnTarget || !TargetDetectionComponent->IsTargetStillLockable(NewTarget))
 		return;
 
-	// �л�ǰ��ǿ����������UI��ȷ��û������
+	// 切换前先隐藏旧目标的UI
 	HideAllLockOnWidgets();
 
-	// ֻ�ڱ�Ҫʱˢ�º�ѡĿ���б�
-	if (LockOnCandidates.Num() == 0)
-	{
-		FindLockOnCandidates();
-	}
+	PreviousLockOnTarget = CurrentLockOnTarget;
+	CurrentLockOnTarget = NewTarget;
+	TargetDetectionComponent->SetFocusTarget(NewTarget);
+	StartSmoothTargetSwitch(NewTarget);
+	ShowLockOnWidget();
+}
 
-	int32 CurrentIndex = LockOnCandidates.Find(CurrentLockOnTarget);
-	if (CurrentIndex != INDEX_NONE && CurrentIndex < LockOnCandidates.Num() - 1)
-	{
-		int32 NewIndex = CurrentIndex + 1;
-		AActor* NewTarget = LockOnCandidates[NewIndex];
-		
-		if (IsValidLockOnTarget(NewTarget))
-		{
-			PreviousLockOnTarget = CurrentLockOnTarget;
-			CurrentLockOnTarget = NewTarget;
-			StartSmoothTargetSwitch(NewTarget);
-			ShowLockOnWidget();
-		}
-	}
+void AMyCharacter::SwitchLockOnTargetRight()
+{
+	if (!bIsLockedOn || !TargetDetectionComponent)
+		return;
+
+	// 切换目标由检测组件随每次搜索预先算好，输入当帧直接开始切换
+	AActor* NewTarget = TargetDetectionComponent->GetRightSwitchTarget();
+	if (!NewTarget || NewTarget == CurrentLockOnTarget || !TargetDetectionComponent->IsTargetStillLockable(NewTarget))
+		return;
+
+	// 切换前先隐藏旧目标的UI
+	HideAllLockOnWidgets();
+
+	PreviousLockOnTarget = CurrentLockOnTarget;
+	CurrentLockOnTarget = NewTarget;
+	TargetDetectionComponent->SetFocusTarget(NewTarget);
+	StartSmoothTargetSwitch(NewTarget);
+	ShowLockOnWidget();
 }
 
 void AMyCharacter::DebugInputTest()
@@ -1694,10 +1793,11 @@ FVector AMyCharacter::GetTargetSocketWorldLocation(AActor* Target) const
 
 	// ���İ�ȡĿ��Ĺ����������
 	USkeletalMeshComponent* SkeletalMesh = Target->FindComponentByClass<USkeletalMeshComponent>();
-	if (SkeletalMesh && SkeletalMesh->DoesSocketExist(TargetSocketName))
+	const FResolvedSocket* ResolvedSocket = FSocketResolutionCache::Resolve(SkeletalMesh, TargetSocketName);
+	if (ResolvedSocket && ResolvedSocket->IsValid())
 	{
 		// ���Socket���ڣ�����Socket������λ�ü���ƫ��
-		FVector SocketLocation = SkeletalMesh->GetSocketLocation(TargetSocketName);
+		FVector SocketLocation = FSocketResolutionCache::GetSocketWorldLocation(SkeletalMesh, *ResolvedSocket);
 		FVector FinalLocation = SocketLocation + SocketOffset;
 		
 		// �����Ż��� ع�͸�Ƶ��־
@@ -1730,7 +1830,8 @@ bool AMyCharacter::HasValidSocket(AActor* Target) const
 	USkeletalMeshComponent* SkeletalMesh = Target->FindComponentByClass<USkeletalMeshComponent>();
 	if (SkeletalMesh)
 	{
-		bool bSocketExists = SkeletalMesh->DoesSocketExist(TargetSocketName);
+		const FResolvedSocket* ResolvedSocket = FSocketResolutionCache::Resolve(SkeletalMesh, TargetSocketName);
+		bool bSocketExists = ResolvedSocket && ResolvedSocket->IsValid();
 		// �����Ż��� ع�͸�Ƶ��־
 		// UE_LOG(LogTemp, Verbose, TEXT("Socket check for '%s': Socket '%s' exists = %s"), 
 		//		*Target->GetName(), *TargetSocketName.ToString(), bSocketExists ? TEXT("YES") : TEXT("NO"));
@@ -1957,16 +2058,10 @@ void AMyCharacter::UpdateSocketProjectionWidget()
 		// Debug log - including Socket information - ���ӽ�Ƶ����
 		if (bEnableCameraDebugLogs)
 		{
-			static float LastSocketProjectionLogTime = 0.0f;
-			float CurrentTime = GetWorld()->GetTimeSeconds();
-			if (CurrentTime - LastSocketProjectionLogTime > 1.0f) // ÿ1���¼һ��
-			{
-				UE_LOG(LogTemp, Warning, TEXT("Socket projection updated: Socket(%s) World(%.1f, %.1f, %.1f) -> Screen(%.1f, %.1f)"), 
-					*TargetSocketName.ToString(),
-					SocketWorldLocation.X, SocketWorldLocation.Y, SocketWorldLocation.Z,
-					ScreenPosition.X, ScreenPosition.Y);
-				LastSocketProjectionLogTime = CurrentTime;
-			}
+			SOUL_LOG_WARNING_RATE_LIMITED(SocketProjection, 1.0, TEXT("Socket projection updated: Socket(%s) World(%.1f, %.1f, %.1f) -> Screen(%.1f, %.1f)"), 
+				*TargetSocketName.ToString(),
+				SocketWorldLocation.X, SocketWorldLocation.Y, SocketWorldLocation.Z,
+				ScreenPosition.X, ScreenPosition.Y);
 		}
 	}
 	else
@@ -2588,6 +2683,169 @@ void AMyCharacter::RestoreCameraFollowState()
 	}
 }
 
+// ==================== 锁定状态复制 ====================
+
+void AMyCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	// 推送模型：只在标记脏后才比较与发送；拥有者本地预测，不需要回传
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	Params.Condition = COND_SkipOwner;
+	DOREPLIFETIME_WITH_PARAMS_FAST(AMyCharacter, ReplicatedLockOn, Params);
+}
+
+void AMyCharacter::UpdateLockOnReplication(float DeltaTime)
+{
+	if (!IsLocallyControlled() || GetNetMode() == NM_Standalone)
+		return;
+
+	FReplicatedLockOnState NewState = PredictedLockOn;
+	if (Controller)
+	{
+		NewState.SetCameraRotation(Controller->GetControlRotation());
+	}
+
+	// 目标变化（锁定/切换/取消）：本地已经生效，视为预测，可靠发送并递增序号
+	if (NewState.Target != CurrentLockOnTarget)
+	{
+		NewState.Target = CurrentLockOnTarget;
+		++NewState.SwitchSequence;
+		PredictedLockOn = NewState;
+		LockOnCameraSendTimer = LOCKON_CAMERA_SEND_INTERVAL;
+
+		if (HasAuthority())
+		{
+			SetAuthoritativeLockOnState(NewState);
+		}
+		else
+		{
+			ServerSetLockOnState(NewState);
+		}
+		return;
+	}
+
+	// 锁定期间：量化后的朝向变化才发送，并限制频率
+	LockOnCameraSendTimer -= DeltaTime;
+	if (!NewState.IsLockedOn() || NewState.HasSameCamera(PredictedLockOn) || LockOnCameraSendTimer > 0.0f)
+		return;
+
+	PredictedLockOn = NewState;
+	LockOnCameraSendTimer = LOCKON_CAMERA_SEND_INTERVAL;
+
+	if (HasAuthority())
+	{
+		SetAuthoritativeLockOnState(NewState);
+	}
+	else
+	{
+		ServerUpdateLockOnCamera(NewState.PackedYaw, NewState.PackedPitch);
+	}
+}
+
+void AMyCharacter::SetAuthoritativeLockOnState(const FReplicatedLockOnState& NewState)
+{
+	if (NewState == ReplicatedLockOn)
+		return;
+
+	const bool bTargetChanged = NewState.Target != ReplicatedLockOn.Target;
+	ReplicatedLockOn = NewState;
+	MARK_PROPERTY_DIRTY_FROM_NAME(AMyCharacter, ReplicatedLockOn, this);
+
+	// 服务器上不会触发OnRep，直接广播
+	if (bTargetChanged)
+	{
+		OnReplicatedLockOnChanged.Broadcast(this, ReplicatedLockOn.Target);
+	}
+}
+
+void AMyCharacter::ServerSetLockOnState_Implementation(const FReplicatedLockOnState& NewState)
+{
+	// 服务器校验：目标必须仍可锁定（存活且在范围内），取消锁定总是接受
+	const bool bValidTarget = !NewState.Target
+		|| (TargetDetectionComponent && TargetDetectionComponent->IsTargetStillLockable(NewState.Target));
+
+	if (!bValidTarget)
+	{
+		// 保留服务器状态，带上客户端的序号让它回滚这次预测
+		FReplicatedLockOnState Correction = ReplicatedLockOn;
+		Correction.SwitchSequence = NewState.SwitchSequence;
+		ClientCorrectLockOnState(Correction);
+
+		SOUL_LOG_WARNING_RATE_LIMITED(LockOn, 1.0f, TEXT("Rejected lock-on prediction %s -> %s (seq %d)"),
+			*GetName(), *GetNameSafe(NewState.Target), NewState.SwitchSequence);
+		return;
+	}
+
+	SetAuthoritativeLockOnState(NewState);
+}
+
+void AMyCharacter::ServerUpdateLockOnCamera_Implementation(uint16 PackedYaw, uint8 PackedPitch)
+{
+	if (!ReplicatedLockOn.IsLockedOn())
+		return;
+
+	FReplicatedLockOnState NewState = ReplicatedLockOn;
+	NewState.PackedYaw = PackedYaw;
+	NewState.PackedPitch = PackedPitch;
+	SetAuthoritativeLockOnState(NewState);
+}
+
+void AMyCharacter::ClientCorrectLockOnState_Implementation(const FReplicatedLockOnState& AuthoritativeState)
+{
+	// 之后已有更新的预测时，这次纠正已过期
+	if (PredictedLockOn.SwitchSequence != AuthoritativeState.SwitchSequence)
+		return;
+
+	// 回滚到服务器的目标；同步预测状态，避免下一帧把回滚当作新的变化再次发送
+	PredictedLockOn.Target = AuthoritativeState.Target;
+	if (AuthoritativeState.Target)
+	{
+		if (AuthoritativeState.Target != CurrentLockOnTarget)
+		{
+			StartLockOn(AuthoritativeState.Target);
+		}
+	}
+	else if (bIsLockedOn)
+	{
+		CancelLockOn();
+	}
+}
+
+void AMyCharacter::OnRep_ReplicatedLockOn(const FReplicatedLockOnState& OldState)
+{
+	if (OldState.Target != ReplicatedLockOn.Target)
+	{
+		OnReplicatedLockOnChanged.Broadcast(this, ReplicatedLockOn.Target);
+	}
+}
+
+// ==================== 编译后的共享锁定设置 ====================
+
+void AMyCharacter::RebuildCompiledLockOnSettings()
+{
+	// 锁定参数来自目标检测组件，相机参数来自相机控制组件
+	FLockOnSettings LockOnSource = TargetDetectionComponent ? TargetDetectionComponent->LockOnSettings : FLockOnSettings();
+	FCameraSettings CameraSource = CameraControlComponent ? CameraControlComponent->CameraSettings : FCameraSettings();
+	FAdvancedCameraSettings AdvancedSource = CameraControlComponent ? CameraControlComponent->AdvancedCameraSettings : FAdvancedCameraSettings();
+	
+	CompiledLockOnSettings = FCompiledLockOnSettings::Build(LockOnSource, CameraSource, AdvancedSource);
+	
+	if (TargetDetectionComponent)
+	{
+		TargetDetectionComponent->SetCompiledSettings(CompiledLockOnSettings);
+	}
+	if (CameraControlComponent)
+	{
+		CameraControlComponent->SetCompiledSettings(CompiledLockOnSettings);
+	}
+	if (UIManagerComponent)
+	{
+		UIManagerComponent->SetCompiledSettings(CompiledLockOnSettings);
+	}
+}
+
 // ==================== 调试命令设置 ====================
 
 void AMyCharacter::SetupDebugCommands()
@@ -2640,8 +2898,12 @@ void AMyCharacter::PostEditChangeProperty(FPropertyChangedEvent& PropertyChanged
 		
 		if (TargetDetectionComponent)
 		{
-			TargetDetectionComponent->LockOnSettings.LockOnRange = LockOnRange;
+			FLockOnSettings UpdatedSettings = TargetDetectionComponent->LockOnSettings;
+			UpdatedSettings.LockOnRange = LockOnRange;
+			TargetDetectionComponent->SetLockOnSettings(UpdatedSettings);
 		}
+		
+		RebuildCompiledLockOnSettings();
 	}
 }
 
@@ -13,8 +13,10 @@
 #include "ExecutionComponent.h"
 #include "CameraPresetComponent.h"
 #include "CameraDebugComponent.h"
+#include "InputReplayComponent.h"
 #include "LockOnConfig.h"
 #include "CameraSetupConfig.h"
+#include "LockOnReplication.h"
 #include "MyCharacter.generated.h"
 
 // 前置声明
@@ -28,6 +30,10 @@ class UCanvasPanelSlot;  // 用于Socket投射系统
 class UTargetDetectionComponent; // 目标检测组件
 class UCameraControlComponent; // 相机控制组件
 class UCameraPresetComponent; // 相机预设组件
+class AMyCharacter;
+
+// 复制的锁定目标变化事件（其他玩家的角色上触发）
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnReplicatedLockOnChanged, AMyCharacter*, Character, AActor*, Target);
 
 UCLASS()
 class SOUL_API AMyCharacter : public ACharacter
@@ -76,6 +82,10 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Soul Components")
 	UExecutionComponent* ExecutionComponent;
 
+	/** 输入回放组件（确定性录制与回放） */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+	UInputReplayComponent* InputReplayComponent;
+
 	// ==================== 锁定检测组件 ====================
 	/** 锁定检测球体组件 - 用于检测可锁定目标 */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Lock On System", meta = (DisplayName = "Lock-On Detection Sphere"))
@@ -328,6 +338,10 @@ protected:
 	// 锁定按钮处理
 	void HandleLockOnButton();
 
+	// 左右切换目标按键处理（区别于右摇杆触发的切换，便于输入录制）
+	void HandleSwitchTargetLeftButton();
+	void HandleSwitchTargetRightButton();
+
 	// 调试函数
 	void DebugInputTest();
 
@@ -488,6 +502,26 @@ protected:
 	UFUNCTION(BlueprintCallable, Category = "Debug")
 	void TestCameraSystem();
 
+	// ==================== 锁定状态复制 ====================
+	/** 复制给其他连接的锁定状态（推送模型，拥有者本地预测故跳过拥有者） */
+	UPROPERTY(ReplicatedUsing = OnRep_ReplicatedLockOn)
+	FReplicatedLockOnState ReplicatedLockOn;
+
+	UFUNCTION()
+	void OnRep_ReplicatedLockOn(const FReplicatedLockOnState& OldState);
+
+	/** 客户端发送预测的锁定目标（目标变化时） */
+	UFUNCTION(Server, Reliable)
+	void ServerSetLockOnState(const FReplicatedLockOnState& NewState);
+
+	/** 客户端发送量化的相机朝向（锁定期间，限频） */
+	UFUNCTION(Server, Unreliable)
+	void ServerUpdateLockOnCamera(uint16 PackedYaw, uint8 PackedPitch);
+
+	/** 服务器拒绝预测时纠正客户端 */
+	UFUNCTION(Client, Reliable)
+	void ClientCorrectLockOnState(const FReplicatedLockOnState& AuthoritativeState);
+
 private:
 	// ==================== 相机组件查找辅助函数 ====================
 	/** 查找CameraBoom组件（多策略容错） */
@@ -506,6 +540,30 @@ private:
 	/** 输出相机状态信息 */
 	void LogCameraState(const FString& Context);
 
+	// ==================== 编译后的共享锁定设置 ====================
+	/** 所有锁定相关组件共享的编译后设置 */
+	TSharedPtr<const FCompiledLockOnSettings> CompiledLockOnSettings;
+
+	/** 根据组件当前配置重建编译后的设置并分发给各组件 */
+	void RebuildCompiledLockOnSettings();
+
+	// ==================== 锁定状态复制 ====================
+	/** 检测本地锁定状态的变化并发布（本地控制的角色每帧调用） */
+	void UpdateLockOnReplication(float DeltaTime);
+
+	/** 服务器写入权威状态并标记脏 */
+	void SetAuthoritativeLockOnState(const FReplicatedLockOnState& NewState);
+
+	/** 本地预测并已发出的状态（UPROPERTY使GC跟踪其中的目标，目标销毁后自动置空） */
+	UPROPERTY(Transient)
+	FReplicatedLockOnState PredictedLockOn;
+
+	/** 距离下次允许发送相机朝向的时间 */
+	float LockOnCameraSendTimer = 0.0f;
+
+	/** 锁定期间相机朝向的最短发送间隔（秒） */
+	static constexpr float LOCKON_CAMERA_SEND_INTERVAL = 0.1f;
+
 public:
 	// Called every frame
 	virtual void Tick(float DeltaTime) override;
@@ -513,6 +571,9 @@ public:
 	// Called to bind functionality to input
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 
+	/** 回放一帧录制的输入（按输入组件的顺序：先动作后轴） */
+	void ApplyReplayFrame(const FInputReplayFrame& Frame);
+
 	// ==================== 公共接口 ====================
 	UFUNCTION(BlueprintCallable, Category = "LockOn")
 	bool IsLockedOn() const { return bIsLockedOn; }
@@ -520,6 +581,20 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "LockOn")
 	AActor* GetLockOnTarget() const { return CurrentLockOnTarget; }
 
+	// ==================== 锁定状态复制 ====================
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	/** 网络上的锁定状态（本地控制的角色返回自己的预测状态） */
+	const FReplicatedLockOnState& GetReplicatedLockOnState() const { return IsLocallyControlled() ? PredictedLockOn : ReplicatedLockOn; }
+
+	/** 网络上的锁定目标（其他玩家的角色也能读取） */
+	UFUNCTION(BlueprintPure, Category = "LockOn|Network")
+	AActor* GetReplicatedLockOnTarget() const { return GetReplicatedLockOnState().Target; }
+
+	/** 复制的锁定目标变化时触发 */
+	UPROPERTY(BlueprintAssignable, Category = "LockOn|Network")
+	FOnReplicatedLockOnChanged OnReplicatedLockOnChanged;
+
 	// ==================== 相机配置动态调整接口 ====================
 	/** 应用指定的相机配置 */
 	UFUNCTION(BlueprintCallable, Category = "Camera Configuration")
@@ -3,10 +3,14 @@
 #include "Engine/World.h"
 #include "HAL/PlatformFileManager.h"
 #include "Misc/DateTime.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "SoulTrace.h"
 
 // ǰ������
 class USoulDebugSettings;
 
+int32 UPerformanceProfiler::NumMonitoringProfilers = 0;
+
 // UPerformanceProfilerʵ��
 
 void UPerformanceProfiler::Initialize(FSubsystemCollectionBase& Collection)
@@ -21,6 +25,13 @@ void UPerformanceProfiler::Initialize(FSubsystemCollectionBase& Collection)
 	
 	UE_LOG(LogTemp, Warning, TEXT("PerformanceProfiler: Performance monitoring %s"), 
 		bIsPerformanceMonitoringEnabled ? TEXT("ENABLED") : TEXT("DISABLED"));
+
+	if (bIsPerformanceMonitoringEnabled)
+	{
+		++NumMonitoringProfilers;
+	}
+
+	InitializeCameraMetricHistograms();
 }
 
 void UPerformanceProfiler::Deinitialize()
@@ -31,6 +42,11 @@ void UPerformanceProfiler::Deinitialize()
 		PrintPerformanceReport();
 	}
 	
+	if (bIsPerformanceMonitoringEnabled)
+	{
+		--NumMonitoringProfilers;
+	}
+	
 	PerformanceMap.Reset();
 	Super::Deinitialize();
 }
@@ -85,6 +101,11 @@ void UPerformanceProfiler::ResetPerformanceData()
 	int32 PreviousCount = PerformanceMap.Num();
 	PerformanceMap.Reset();
 	
+	for (FCameraMetricHistogram& Histogram : CameraMetricHistograms)
+	{
+		Histogram.Reset();
+	}
+	
 	UE_LOG(LogTemp, Warning, TEXT("PerformanceProfiler: Reset performance data (%d functions cleared)"), PreviousCount);
 }
 
@@ -93,6 +114,7 @@ void UPerformanceProfiler::PrintPerformanceReport()
 	if (PerformanceMap.Num() == 0)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("PerformanceProfiler: No performance data to report"));
+		PrintCameraQualityReport();
 		return;
 	}
 
@@ -158,6 +180,8 @@ void UPerformanceProfiler::PrintPerformanceReport()
 	UE_LOG(LogTemp, Warning, TEXT("- Slowest function: %s (avg: %s)"), *SlowestFunction, *FormatTime(MaxAvgTime));
 	UE_LOG(LogTemp, Warning, TEXT("=============================="));
 	UE_LOG(LogTemp, Warning, TEXT(""));
+
+	PrintCameraQualityReport();
 }
 
 FPerformanceData UPerformanceProfiler::GetFunctionPerformanceData(const FString& FunctionName)
@@ -181,6 +205,11 @@ void UPerformanceProfiler::SetPerformanceMonitoringEnabled(bool bEnabled)
 	bool bPreviousState = bIsPerformanceMonitoringEnabled;
 	bIsPerformanceMonitoringEnabled = bEnabled;
 	
+	if (bPreviousState != bEnabled)
+	{
+		NumMonitoringProfilers += bEnabled ? 1 : -1;
+	}
+	
 	UE_LOG(LogTemp, Warning, TEXT("PerformanceProfiler: Performance monitoring %s -> %s"), 
 		bPreviousState ? TEXT("ENABLED") : TEXT("DISABLED"),
 		bEnabled ? TEXT("ENABLED") : TEXT("DISABLED"));
@@ -259,18 +288,146 @@ FString UPerformanceProfiler::FormatTime(float TimeInMs) const
 	}
 }
 
+// 相机质量指标
+
+void UPerformanceProfiler::InitializeCameraMetricHistograms()
+{
+	CameraMetricHistograms.SetNum((int32)ECameraQualityMetric::Count);
+
+	// 桶宽按各指标的量纲选择，32个桶覆盖常见范围
+	CameraMetricHistograms[(int32)ECameraQualityMetric::AngularVelocity].Init(TEXT("AngularVelocity (deg/s)"), 10.0f);
+	CameraMetricHistograms[(int32)ECameraQualityMetric::AngularJerk].Init(TEXT("AngularJerk (deg/s^3)"), 500.0f);
+	CameraMetricHistograms[(int32)ECameraQualityMetric::ScreenOffset].Init(TEXT("ScreenOffset (0-1)"), 0.025f);
+	CameraMetricHistograms[(int32)ECameraQualityMetric::TimeToAcquire].Init(TEXT("TimeToAcquire (s)"), 0.05f);
+	CameraMetricHistograms[(int32)ECameraQualityMetric::SwitchCompletion].Init(TEXT("SwitchCompletion (s)"), 0.05f);
+}
+
+void UPerformanceProfiler::RecordCameraMetric(ECameraQualityMetric Metric, float Value)
+{
+	if (!bIsPerformanceMonitoringEnabled || !CameraMetricHistograms.IsValidIndex((int32)Metric))
+	{
+		return;
+	}
+
+	CameraMetricHistograms[(int32)Metric].AddSample(Value);
+}
+
+FCameraMetricHistogram UPerformanceProfiler::GetCameraMetricHistogram(ECameraQualityMetric Metric) const
+{
+	if (CameraMetricHistograms.IsValidIndex((int32)Metric))
+	{
+		return CameraMetricHistograms[(int32)Metric];
+	}
+
+	return FCameraMetricHistogram();
+}
+
+bool UPerformanceProfiler::IsCameraQualityWithinBounds(const FCameraQualityBounds& Bounds) const
+{
+	if (CameraMetricHistograms.Num() != (int32)ECameraQualityMetric::Count)
+	{
+		return true;
+	}
+
+	const float Limits[(int32)ECameraQualityMetric::Count] =
+	{
+		Bounds.MaxAngularVelocity,
+		Bounds.MaxAngularJerk,
+		Bounds.MaxScreenOffset,
+		Bounds.MaxTimeToAcquire,
+		Bounds.MaxSwitchCompletion
+	};
+
+	bool bWithinBounds = true;
+	for (int32 MetricIndex = 0; MetricIndex < CameraMetricHistograms.Num(); ++MetricIndex)
+	{
+		const FCameraMetricHistogram& Histogram = CameraMetricHistograms[MetricIndex];
+		const float Value = Histogram.GetPercentile(Bounds.Percentile);
+		if (Histogram.SampleCount > 0 && Value > Limits[MetricIndex])
+		{
+			UE_LOG(LogTemp, Warning, TEXT("PerformanceProfiler: Camera quality out of bounds - %s P%.0f = %.3f (limit %.3f)"),
+				*Histogram.MetricName, Bounds.Percentile, Value, Limits[MetricIndex]);
+			bWithinBounds = false;
+		}
+	}
+
+	return bWithinBounds;
+}
+
+void UPerformanceProfiler::PrintCameraQualityReport() const
+{
+	bool bHasSamples = false;
+	for (const FCameraMetricHistogram& Histogram : CameraMetricHistograms)
+	{
+		bHasSamples |= Histogram.SampleCount > 0;
+	}
+
+	if (!bHasSamples)
+	{
+		return;
+	}
+
+	UE_LOG(LogTemp, Warning, TEXT("=== SOUL CAMERA QUALITY REPORT ==="));
+	UE_LOG(LogTemp, Warning, TEXT("%-28s | %8s | %10s | %10s | %10s | %10s"),
+		TEXT("Metric"), TEXT("Samples"), TEXT("Avg"), TEXT("P50"), TEXT("P95"), TEXT("Max"));
+
+	for (const FCameraMetricHistogram& Histogram : CameraMetricHistograms)
+	{
+		if (Histogram.SampleCount == 0)
+		{
+			continue;
+		}
+
+		UE_LOG(LogTemp, Warning, TEXT("%-28s | %8d | %10.3f | %10.3f | %10.3f | %10.3f"),
+			*Histogram.MetricName,
+			Histogram.SampleCount,
+			Histogram.GetAverage(),
+			Histogram.GetPercentile(50.0f),
+			Histogram.GetPercentile(95.0f),
+			Histogram.MaxValue);
+	}
+
+	UE_LOG(LogTemp, Warning, TEXT("=================================="));
+}
+
 // FSoulPerformanceScopeʵ��
 
-FSoulPerformanceScope::FSoulPerformanceScope(const FString& InFunctionName)
+FSoulPerformanceScope::FSoulPerformanceScope(const TCHAR* InFunctionName)
 	: FunctionName(InFunctionName)
 	, StartTime(0.0)
+	, bRecordTime(UPerformanceProfiler::IsAnyMonitoringEnabled())
 {
 	// ��¼��ʼʱ�䣨����Ϊ��λ��
-	StartTime = FPlatformTime::Seconds();
+#if CPUPROFILERTRACE_ENABLED
+	// SoulLockOn通道开启时同时输出Insights的CPU事件
+	if (UE_TRACE_CHANNELEXPR_IS_ENABLED(SoulLockOnChannel))
+	{
+		FCpuProfilerTrace::OutputBeginDynamicEvent(FunctionName);
+		bTraceEventOpen = true;
+	}
+#endif
+
+	// 没有分析器开启监控时不计时，析构也不查找分析器（Insights事件只取决于追踪通道）
+	if (bRecordTime)
+	{
+		StartTime = FPlatformTime::Seconds();
+	}
 }
 
 FSoulPerformanceScope::~FSoulPerformanceScope()
 {
+#if CPUPROFILERTRACE_ENABLED
+	if (bTraceEventOpen)
+	{
+		FCpuProfilerTrace::OutputEndEvent();
+	}
+#endif
+
+	if (!bRecordTime)
+	{
+		return;
+	}
+
 	// ����ִ��ʱ�䣨ת��Ϊ���룩
 	double EndTime = FPlatformTime::Seconds();
 	float ElapsedTimeMs = static_cast<float>((EndTime - StartTime) * 1000.0);
@@ -56,6 +56,144 @@ struct SOUL_API FPerformanceData
 	}
 };
 
+/**
+ * 相机质量指标
+ * 与耗时数据一起统计，用于确认性能优化没有损害相机手感
+ */
+UENUM(BlueprintType)
+enum class ECameraQualityMetric : uint8
+{
+	AngularVelocity		UMETA(DisplayName = "Angular Velocity"),	// 相机角速度（度/秒）
+	AngularJerk			UMETA(DisplayName = "Angular Jerk"),		// 相机角加加速度（度/秒³）
+	ScreenOffset		UMETA(DisplayName = "Screen Offset"),		// 锁定目标偏离屏幕中心（0=中心，1=屏幕边缘）
+	TimeToAcquire		UMETA(DisplayName = "Time To Acquire"),		// 锁定后相机对准目标的耗时（秒）
+	SwitchCompletion	UMETA(DisplayName = "Switch Completion"),	// 平滑切换目标的完成耗时（秒）
+	Count				UMETA(Hidden)
+};
+
+/**
+ * 相机质量指标直方图
+ * 固定宽度分桶，最后一个桶收集所有超出范围的样本
+ */
+USTRUCT(BlueprintType)
+struct SOUL_API FCameraMetricHistogram
+{
+	GENERATED_BODY()
+
+	/** 分桶数量 */
+	static constexpr int32 NUM_BUCKETS = 32;
+
+	/** 指标名称 */
+	UPROPERTY(BlueprintReadOnly, Category = "Performance")
+	FString MetricName;
+
+	/** 单个桶的宽度 */
+	UPROPERTY(BlueprintReadOnly, Category = "Performance")
+	float BucketWidth = 1.0f;
+
+	/** 各桶样本数 */
+	UPROPERTY(BlueprintReadOnly, Category = "Performance")
+	TArray<int32> Buckets;
+
+	/** 样本总数 */
+	UPROPERTY(BlueprintReadOnly, Category = "Performance")
+	int32 SampleCount = 0;
+
+	/** 最大值 */
+	UPROPERTY(BlueprintReadOnly, Category = "Performance")
+	float MaxValue = 0.0f;
+
+	/** 样本总和 */
+	float Sum = 0.0f;
+
+	void Init(const FString& InMetricName, float InBucketWidth)
+	{
+		MetricName = InMetricName;
+		BucketWidth = FMath::Max(InBucketWidth, KINDA_SMALL_NUMBER);
+		Reset();
+	}
+
+	void Reset()
+	{
+		Buckets.Init(0, NUM_BUCKETS);
+		SampleCount = 0;
+		MaxValue = 0.0f;
+		Sum = 0.0f;
+	}
+
+	void AddSample(float Value)
+	{
+		if (Buckets.Num() != NUM_BUCKETS)
+		{
+			Buckets.Init(0, NUM_BUCKETS);
+		}
+
+		const int32 BucketIndex = FMath::Clamp(FMath::FloorToInt(Value / BucketWidth), 0, NUM_BUCKETS - 1);
+		Buckets[BucketIndex]++;
+		SampleCount++;
+		MaxValue = SampleCount == 1 ? Value : FMath::Max(MaxValue, Value);
+		Sum += Value;
+	}
+
+	float GetAverage() const
+	{
+		return SampleCount > 0 ? Sum / SampleCount : 0.0f;
+	}
+
+	/** 百分位数（返回所在桶的上边界，溢出桶返回最大值） */
+	float GetPercentile(float Percentile) const
+	{
+		if (SampleCount == 0)
+			return 0.0f;
+
+		const int32 TargetCount = FMath::CeilToInt(SampleCount * FMath::Clamp(Percentile, 0.0f, 100.0f) / 100.0f);
+		int32 Accumulated = 0;
+		for (int32 BucketIndex = 0; BucketIndex < Buckets.Num(); ++BucketIndex)
+		{
+			Accumulated += Buckets[BucketIndex];
+			if (Accumulated >= TargetCount)
+			{
+				return BucketIndex == NUM_BUCKETS - 1 ? MaxValue : FMath::Min((BucketIndex + 1) * BucketWidth, MaxValue);
+			}
+		}
+		return MaxValue;
+	}
+};
+
+/**
+ * 相机质量门限
+ * 指定百分位数上各指标允许的最大值，用于在性能改动后检查相机手感是否退化
+ */
+USTRUCT(BlueprintType)
+struct SOUL_API FCameraQualityBounds
+{
+	GENERATED_BODY()
+
+	/** 检查使用的百分位数 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera Quality", meta = (ClampMin = "50.0", ClampMax = "100.0"))
+	float Percentile = 95.0f;
+
+	/** 最大角速度（度/秒） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera Quality")
+	float MaxAngularVelocity = 180.0f;
+
+	/** 最大角加加速度（度/秒³） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera Quality")
+	float MaxAngularJerk = 8000.0f;
+
+	/** 最大屏幕偏移（0-1） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera Quality")
+	float MaxScreenOffset = 0.3f;
+
+	/** 最大锁定对准耗时（秒） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera Quality")
+	float MaxTimeToAcquire = 0.5f;
+
+	/** 最大切换完成耗时（秒） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera Quality")
+	float MaxSwitchCompletion = 0.6f;
+};
+
 /**
  * ���ܷ�������ϵͳ
  * �����ռ��ͷ�������ִ������
@@ -127,6 +265,39 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Performance Profiler", meta = (WorldContext = "WorldContextObject"))
 	static UPerformanceProfiler* GetPerformanceProfiler(const UObject* WorldContextObject);
 
+	/** 是否有任一分析器开启了监控（性能作用域据此跳过计时与查找，无需访问世界） */
+	static bool IsAnyMonitoringEnabled() { return NumMonitoringProfilers > 0; }
+
+	// ==================== 相机质量指标 ====================
+
+	/**
+	 * 记录一个相机质量样本
+	 * @param Metric 指标类型
+	 * @param Value 样本值
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Performance Profiler")
+	void RecordCameraMetric(ECameraQualityMetric Metric, float Value);
+
+	/**
+	 * 获取指定指标的直方图
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Performance Profiler")
+	FCameraMetricHistogram GetCameraMetricHistogram(ECameraQualityMetric Metric) const;
+
+	/**
+	 * 检查相机质量是否在门限之内（超出的指标会输出到日志）
+	 * @param Bounds 各指标的门限
+	 * @return 全部指标都在门限内时返回true
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Performance Profiler")
+	bool IsCameraQualityWithinBounds(const FCameraQualityBounds& Bounds) const;
+
+	/**
+	 * 打印相机质量报告到日志
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Performance Profiler")
+	void PrintCameraQualityReport() const;
+
 private:
 	/** ��������ӳ��� */
 	UPROPERTY()
@@ -139,6 +310,16 @@ private:
 	/** ������������ͳ����Ϣ */
 	void UpdatePerformanceStatistics(FPerformanceData& Data, float ElapsedTime);
 
+	/** 开启监控的分析器实例数（只在游戏线程修改） */
+	static int32 NumMonitoringProfilers;
+
+	/** 相机质量直方图（按ECameraQualityMetric索引） */
+	UPROPERTY()
+	TArray<FCameraMetricHistogram> CameraMetricHistograms;
+
+	/** 按各指标的量纲初始化直方图 */
+	void InitializeCameraMetricHistograms();
+
 	/** ��ʽ��ʱ��Ϊ�ɶ��ַ��� */
 	FString FormatTime(float TimeInMs) const;
 };
@@ -152,12 +333,19 @@ private:
 struct SOUL_API FSoulPerformanceScope
 {
 public:
-	FSoulPerformanceScope(const FString& InFunctionName);
+	/** InFunctionName需在作用域内保持有效（通常为TEXT字面量） */
+	FSoulPerformanceScope(const TCHAR* InFunctionName);
 	~FSoulPerformanceScope();
 
 private:
-	FString FunctionName;
+	const TCHAR* FunctionName;
 	double StartTime;
+
+	/** 构造时有分析器开启监控，析构时计时并记录 */
+	bool bRecordTime = false;
+
+	/** 构造时SoulLockOn追踪通道已开启，析构时结束对应的Insights事件 */
+	bool bTraceEventOpen = false;
 };
 #endif
 
@@ -5,6 +5,7 @@
 #include "GameFramework/Character.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Kismet/KismetMathLibrary.h"
+#include "CombatStatsSubsystem.h"
 
 // Sets default values for this component's properties
 UPoiseComponent::UPoiseComponent()
@@ -47,12 +48,38 @@ void UPoiseComponent::BeginPlay()
 	PoiseImmuneEndTime = 0.0f;
 	bIsStaggering = false;
 	bManuallySetImmune = false;
+	PoiseChangedEvent.Reset();
+
+	// 注册到战斗数值子系统，由其集中处理恢复
+	if (bUseCombatStatsSubsystem)
+	{
+		if (UCombatStatsSubsystem* Subsystem = GetWorld()->GetSubsystem<UCombatStatsSubsystem>())
+		{
+			CombatStats = Subsystem;
+			CombatStatsSlot = Subsystem->RegisterPoise(this);
+			SetComponentTickEnabled(false);
+			PushCombatStats();
+		}
+	}
 
 	UE_LOG(LogTemp, Warning, TEXT("PoiseComponent: BeginPlay completed for %s"), 
 		OwnerCharacter ? *OwnerCharacter->GetName() : TEXT("Unknown"));
 	UE_LOG(LogTemp, Warning, TEXT("PoiseComponent: Initial Poise: %.1f/%.1f"), CurrentPoise, PoiseSettings.MaxPoise);
 }
 
+// Called when the game ends
+void UPoiseComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UCombatStatsSubsystem* Subsystem = CombatStats.Get())
+	{
+		Subsystem->UnregisterPoise(CombatStatsSlot);
+	}
+	CombatStats.Reset();
+	CombatStatsSlot = INDEX_NONE;
+
+	Super::EndPlay(EndPlayReason);
+}
+
 // Called every frame
 void UPoiseComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
@@ -75,6 +102,9 @@ void UPoiseComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActor
 			EndPoiseImmune();
 		}
 	}
+
+	// 本帧累积的韧性变化最多广播一次
+	FlushPoiseChangedEvent();
 }
 
 // ==================== ���Ľӿں���ʵ�� ====================
@@ -131,6 +161,74 @@ bool UPoiseComponent::TakePoiseDamage(float PoiseDamage, AActor* DamageSource)
 	return true;
 }
 
+int32 UPoiseComponent::TakePoiseDamageBatch(const TArray<FPoiseDamageHit>& Hits)
+{
+	if (!IsValidForPoiseOperations() || Hits.Num() == 0)
+	{
+		return 0;
+	}
+
+	// 免疫或已破防时整批命中都不生效
+	if (IsPoiseImmune() || IsPoiseBroken())
+	{
+		return 0;
+	}
+
+	// 按顺序累加，破防的那一次命中之后不再计入
+	float ResolvedPoise = CurrentPoise;
+	float TotalDamage = 0.0f;
+	int32 AppliedHits = 0;
+	AActor* BreakSource = nullptr;
+	bool bBroken = false;
+
+	for (const FPoiseDamageHit& Hit : Hits)
+	{
+		if (Hit.PoiseDamage <= 0.0f)
+		{
+			continue;
+		}
+
+		++AppliedHits;
+		TotalDamage += Hit.PoiseDamage;
+		ResolvedPoise -= Hit.PoiseDamage;
+
+		if (ResolvedPoise <= 0.0f)
+		{
+			BreakSource = Hit.DamageSource.Get();
+			bBroken = true;
+			break;
+		}
+	}
+
+	if (AppliedHits == 0)
+	{
+		return 0;
+	}
+
+	LastDamageTime = GetWorld()->GetTimeSeconds();
+
+	const float PreviousPoise = CurrentPoise;
+	CurrentPoise = FMath::Max(0.0f, ResolvedPoise);
+
+	if (bBroken)
+	{
+		// 破防内部会广播破防/硬直/韧性变化事件并设置定时器
+		BreakPoise(BreakSource);
+	}
+	else
+	{
+		SetPoiseState(EPoiseState::Damaged);
+
+		// 整批已合并为一次变化，直接广播
+		BroadcastPoiseChanged(true);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("PoiseComponent: Batch of %d hits (%d applied, %.1f damage), poise %.1f -> %.1f"),
+		Hits.Num(), AppliedHits, TotalDamage, PreviousPoise, CurrentPoise);
+
+	return AppliedHits;
+}
+
 void UPoiseComponent::BreakPoise(AActor* DamageSource)
 {
 	if (!IsValidForPoiseOperations())
@@ -157,7 +255,7 @@ void UPoiseComponent::BreakPoise(AActor* DamageSource)
 	OnPoiseBreak.Broadcast(GetOwner(), StaggerDuration, DamageSource);
 
 	// �㲥���Ա仯�¼�
-	BroadcastPoiseChanged();
+	BroadcastPoiseChanged(true);
 
 	UE_LOG(LogTemp, Warning, TEXT("PoiseComponent: Poise broken - Stagger duration: %.2f"), StaggerDuration);
 }
@@ -220,7 +318,7 @@ void UPoiseComponent::ResetPoise()
 	}
 
 	// �㲥���Ա仯�¼�
-	BroadcastPoiseChanged();
+	BroadcastPoiseChanged(true);
 }
 
 void UPoiseComponent::SetPoiseImmune(bool bImmune, float Duration)
@@ -326,8 +424,10 @@ void UPoiseComponent::UpdatePoiseSettings(const FPoiseSettings& NewSettings)
 		CurrentPoise = FMath::Clamp(CurrentPoise, 0.0f, NewSettings.MaxPoise);
 
 		// �㲥���Ա仯�¼�
-		BroadcastPoiseChanged();
+		BroadcastPoiseChanged(true);
 	}
+
+	PushCombatStats();
 }
 
 void UPoiseComponent::SetMaxPoise(float NewMaxPoise)
@@ -358,7 +458,7 @@ void UPoiseComponent::SetMaxPoise(float NewMaxPoise)
 		OldMaxPoise, NewMaxPoise, CurrentPoise);
 
 	// �㲥���Ա仯�¼�
-	BroadcastPoiseChanged();
+	BroadcastPoiseChanged(true);
 }
 
 // ==================== ˽�и�������ʵ�� ====================
@@ -438,6 +538,7 @@ void UPoiseComponent::EndStagger()
 	UE_LOG(LogTemp, Warning, TEXT("PoiseComponent: Ending stagger"));
 
 	bIsStaggering = false;
+	PushCombatStats();
 
 	// ���Ӳֱ��ʱ��
 	GetWorld()->GetTimerManager().ClearTimer(StaggerTimerHandle);
@@ -476,6 +577,12 @@ void UPoiseComponent::EndStagger()
 
 void UPoiseComponent::SetPoiseState(EPoiseState NewState)
 {
+	// 韧性已满时共享子系统不会再发出恢复回调把状态拉回正常，受损/恢复中直接视为正常
+	if ((NewState == EPoiseState::Damaged || NewState == EPoiseState::Recovering) && CurrentPoise >= PoiseSettings.MaxPoise)
+	{
+		NewState = EPoiseState::Normal;
+	}
+
 	if (CurrentPoiseState == NewState)
 	{
 		return;
@@ -484,6 +591,9 @@ void UPoiseComponent::SetPoiseState(EPoiseState NewState)
 	EPoiseState OldState = CurrentPoiseState;
 	CurrentPoiseState = NewState;
 
+	// 只有正常/受损/恢复中的状态才会自动恢复
+	PushCombatStats();
+
 	UE_LOG(LogTemp, Warning, TEXT("PoiseComponent: State changed from %d to %d"), 
 		(int32)OldState, (int32)NewState);
 
@@ -537,14 +647,68 @@ float UPoiseComponent::CalculateStaggerDuration(float PoiseDamage) const
 	return FMath::Clamp(StaggerDuration, 0.1f, 10.0f);
 }
 
-void UPoiseComponent::BroadcastPoiseChanged()
+void UPoiseComponent::BroadcastPoiseChanged(bool bForce)
+{
+	if (!IsValidForPoiseOperations())
+	{
+		return;
+	}
+
+	PushCombatStats();
+
+	// 破防/重置等离散变化立即广播，受击与恢复留到Tick末尾合并
+	if (PoiseChangedEvent.MarkChanged(CurrentPoise, PoiseSettings.MaxPoise, bForce))
+	{
+		PoiseChangedEvent.MarkPublished(CurrentPoise);
+		OnPoiseChanged.Broadcast(GetOwner(), CurrentPoise, PoiseSettings.MaxPoise);
+	}
+	else if (UCombatStatsSubsystem* Subsystem = CombatStats.Get())
+	{
+		// 组件不再Tick，由子系统在帧末回调发布
+		Subsystem->MarkPoiseDirty(CombatStatsSlot);
+	}
+}
+
+void UPoiseComponent::FlushPoiseChangedEvent()
 {
-	if (IsValidForPoiseOperations())
+	if (PoiseChangedEvent.ConsumePending(CurrentPoise, ChangeEventQuantizationStep))
 	{
+		PoiseChangedEvent.MarkPublished(CurrentPoise);
 		OnPoiseChanged.Broadcast(GetOwner(), CurrentPoise, PoiseSettings.MaxPoise);
 	}
 }
 
+void UPoiseComponent::ApplyCombatStats(float RecoveredPoise)
+{
+	if (RecoveredPoise > CurrentPoise)
+	{
+		RecoverPoise(RecoveredPoise - CurrentPoise);
+	}
+
+	FlushPoiseChangedEvent();
+
+	// 组件上的值才是最终结果（免疫/硬直中不恢复），写回共享缓冲
+	PushCombatStats();
+}
+
+void UPoiseComponent::PushCombatStats()
+{
+	UCombatStatsSubsystem* Subsystem = CombatStats.Get();
+	if (!Subsystem)
+	{
+		return;
+	}
+
+	const bool bCanRecover = !bIsStaggering &&
+		(CurrentPoiseState == EPoiseState::Normal ||
+		 CurrentPoiseState == EPoiseState::Damaged ||
+		 CurrentPoiseState == EPoiseState::Recovering);
+
+	Subsystem->UpdatePoise(CombatStatsSlot, CurrentPoise, PoiseSettings.MaxPoise,
+		bCanRecover ? PoiseSettings.PoiseRecoveryRate : 0.0f,
+		LastDamageTime + PoiseSettings.PoiseRecoveryDelay);
+}
+
 bool UPoiseComponent::IsValidForPoiseOperations() const
 {
 	return IsValid(this) && IsValid(GetOwner()) && GetWorld() != nullptr;
@@ -7,8 +7,11 @@
 #include "Engine/Engine.h"
 #include "GameFramework/Character.h"
 #include "TimerManager.h"
+#include "CoalescedValueEvent.h"
 #include "PoiseComponent.generated.h"
 
+class UCombatStatsSubsystem;
+
 // ����״̬ö��
 UENUM(BlueprintType)
 enum class EPoiseState : uint8
@@ -57,6 +60,21 @@ struct FPoiseSettings
 	}
 };
 
+// 单次韧性命中（批量结算用）
+USTRUCT(BlueprintType)
+struct FPoiseDamageHit
+{
+	GENERATED_BODY()
+
+	// 韧性伤害值
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Poise Damage")
+	float PoiseDamage = 0.0f;
+
+	// 伤害来源（可为空；弱引用，排队期间来源被销毁时结算为空）
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Poise Damage")
+	TWeakObjectPtr<AActor> DamageSource;
+};
+
 // �¼�ί������
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnPoiseBreak, AActor*, OwnerActor, float, StaggerDuration, AActor*, DamageSource);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnPoiseChanged, AActor*, OwnerActor, float, CurrentPoise, float, MaxPoise);
@@ -77,6 +95,9 @@ protected:
 	// Called when the game starts
 	virtual void BeginPlay() override;
 
+	// Called when the game ends
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 public:
 	// Called every frame
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
@@ -85,6 +106,14 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Poise Settings")
 	FPoiseSettings PoiseSettings;
 
+	// 韧性变化事件的量化步长（受击与恢复只有跨过步长边界才广播，0表示每帧有变化就广播）
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Poise Events", meta = (ClampMin = "0.0", ClampMax = "25.0"))
+	float ChangeEventQuantizationStep = 1.0f;
+
+	// 由战斗数值子系统集中处理恢复（组件自身不再Tick）
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Poise Settings")
+	bool bUseCombatStatsSubsystem = true;
+
 	// ==================== �¼�ί�� ====================
 	UPROPERTY(BlueprintAssignable, Category = "Poise Events")
 	FOnPoiseBreak OnPoiseBreak;
@@ -112,6 +141,22 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Poise System")
 	bool TakePoiseDamage(float PoiseDamage, AActor* DamageSource = nullptr);
 
+	/**
+	 * 一次结算同一帧内的多次韧性命中
+	 * 只做一次状态检查与恢复延迟重置，按顺序累加伤害，破防后的剩余命中与单次接口一样被忽略；
+	 * 最终只广播一组事件（破防时由造成破防的命中作为来源）。
+	 * @param Hits 本帧的命中列表
+	 * @return 实际生效的命中数
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Poise System")
+	int32 TakePoiseDamageBatch(const TArray<FPoiseDamageHit>& Hits);
+
+	/**
+	 * 由战斗数值子系统回调：应用共享缓冲中积分后的韧性并发布待定事件
+	 * @param RecoveredPoise 子系统积分后的韧性值
+	 */
+	void ApplyCombatStats(float RecoveredPoise);
+
 	/**
 	 * ǿ���ƻ�����
 	 * @param DamageSource �˺���Դ����ѡ��
@@ -234,6 +279,13 @@ protected:
 	// �Ƿ��ֶ��������ߣ��������ƻ�����Զ����ߣ�
 	bool bManuallySetImmune;
 
+	// 韧性变化事件的合并状态
+	FCoalescedValueEvent PoiseChangedEvent;
+
+	// 战斗数值子系统及在其中的槽位（未注册时为INDEX_NONE）
+	TWeakObjectPtr<UCombatStatsSubsystem> CombatStats;
+	int32 CombatStatsSlot = INDEX_NONE;
+
 	// ==================== ˽�и������� ====================
 
 private:
@@ -270,7 +322,17 @@ private:
 	/**
 	 * �㲥���Ա仯�¼�
 	 */
-	void BroadcastPoiseChanged();
+	void BroadcastPoiseChanged(bool bForce = false);
+
+	/**
+	 * 发布本帧合并后的韧性变化事件（Tick末尾调用）
+	 */
+	void FlushPoiseChangedEvent();
+
+	/**
+	 * 把当前韧性与恢复参数推送到战斗数值子系统
+	 */
+	void PushCombatStats();
 
 	/**
 	 * ��֤���״̬
@@ -0,0 +1,57 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "PoiseDamageSubsystem.h"
+
+void UPoiseDamageSubsystem::QueuePoiseDamage(UPoiseComponent* Target, float PoiseDamage, AActor* DamageSource)
+{
+	if (!IsValid(Target) || PoiseDamage <= 0.0f)
+		return;
+
+	FPoiseDamageHit& Hit = PendingHits.FindOrAdd(Target).AddDefaulted_GetRef();
+	Hit.PoiseDamage = PoiseDamage;
+	Hit.DamageSource = DamageSource;
+}
+
+void UPoiseDamageSubsystem::FlushPoiseDamage()
+{
+	if (PendingHits.Num() == 0)
+		return;
+
+	// 事件回调中可能继续入队，先换出本帧的队列
+	Swap(PendingHits, ResolvingHits);
+
+	for (TPair<TWeakObjectPtr<UPoiseComponent>, TArray<FPoiseDamageHit>>& Pair : ResolvingHits)
+	{
+		if (UPoiseComponent* Target = Pair.Key.Get())
+		{
+			Target->TakePoiseDamageBatch(Pair.Value);
+		}
+	}
+
+	ResolvingHits.Reset();
+}
+
+void UPoiseDamageSubsystem::Deinitialize()
+{
+	PendingHits.Empty();
+	ResolvingHits.Empty();
+
+	Super::Deinitialize();
+}
+
+void UPoiseDamageSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	FlushPoiseDamage();
+}
+
+TStatId UPoiseDamageSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UPoiseDamageSubsystem, STATGROUP_Tickables);
+}
+
+bool UPoiseDamageSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
@@ -0,0 +1,46 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "PoiseComponent.h"
+#include "PoiseDamageSubsystem.generated.h"
+
+/**
+ * 韧性伤害队列子系统
+ * 范围攻击与多段连击在同一帧内产生的命中先按目标入队，帧末对每个目标调用一次TakePoiseDamageBatch，
+ * 每个目标只结算一次韧性，并只产生一组事件与定时器。
+ */
+UCLASS()
+class SOUL_API UPoiseDamageSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** 把一次命中加入本帧的队列 */
+	UFUNCTION(BlueprintCallable, Category = "Poise System")
+	void QueuePoiseDamage(UPoiseComponent* Target, float PoiseDamage, AActor* DamageSource = nullptr);
+
+	/** 立即结算所有排队的命中 */
+	UFUNCTION(BlueprintCallable, Category = "Poise System")
+	void FlushPoiseDamage();
+
+	/** 当前排队的目标数 */
+	int32 GetNumPendingTargets() const { return PendingHits.Num(); }
+
+	// UTickableWorldSubsystem
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** 目标 -> 本帧命中 */
+	TMap<TWeakObjectPtr<UPoiseComponent>, TArray<FPoiseDamageHit>> PendingHits;
+
+	/** 结算时换出的队列（结算回调中新入队的命中留到下一帧） */
+	TMap<TWeakObjectPtr<UPoiseComponent>, TArray<FPoiseDamageHit>> ResolvingHits;
+};
@@ -0,0 +1,148 @@
+﻿#include "SocketResolutionCache.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/SkeletalMeshSocket.h"
+
+TMap<TObjectKey<USkeletalMesh>, FSocketResolutionCache::FMeshEntry> FSocketResolutionCache::MeshEntries;
+
+const FResolvedSocket* FSocketResolutionCache::Resolve(const USkeletalMeshComponent* MeshComponent, FName SocketName)
+{
+	FMeshEntry* Entry = FindOrAddEntry(MeshComponent);
+	if (!Entry)
+		return nullptr;
+
+	return &ResolveInEntry(*Entry, MeshComponent->GetSkeletalMeshAsset(), SocketName);
+}
+
+const FResolvedSocket* FSocketResolutionCache::ResolveFirst(const USkeletalMeshComponent* MeshComponent, const TArray<FName>& SocketNames)
+{
+	if (SocketNames.Num() == 0)
+		return nullptr;
+
+	FMeshEntry* Entry = FindOrAddEntry(MeshComponent);
+	if (!Entry)
+		return nullptr;
+
+	uint32 ListHash = GetTypeHash(SocketNames.Num());
+	for (const FName& SocketName : SocketNames)
+	{
+		ListHash = HashCombine(ListHash, GetTypeHash(SocketName));
+	}
+
+	// Priority list already resolved for this mesh
+	if (const FName* Winner = Entry->FirstAvailableByList.Find(ListHash))
+	{
+		if (Winner->IsNone())
+			return nullptr;
+
+		return Entry->Sockets.Find(*Winner);
+	}
+
+	const USkeletalMesh* Mesh = MeshComponent->GetSkeletalMeshAsset();
+	for (const FName& SocketName : SocketNames)
+	{
+		const FResolvedSocket& Resolved = ResolveInEntry(*Entry, Mesh, SocketName);
+		if (Resolved.IsValid())
+		{
+			Entry->FirstAvailableByList.Add(ListHash, SocketName);
+			return Entry->Sockets.Find(SocketName);
+		}
+	}
+
+	Entry->FirstAvailableByList.Add(ListHash, NAME_None);
+	return nullptr;
+}
+
+FVector FSocketResolutionCache::GetSocketWorldLocation(const USkeletalMeshComponent* MeshComponent, const FResolvedSocket& Socket)
+{
+	if (!MeshComponent || !Socket.IsValid())
+		return FVector::ZeroVector;
+
+	// Direct bone transform fetch, no name search
+	FTransform BoneTransform = MeshComponent->GetBoneTransform(Socket.BoneIndex);
+	return BoneTransform.TransformPosition(Socket.LocalTransform.GetLocation());
+}
+
+void FSocketResolutionCache::InvalidateMesh(const USkeletalMesh* Mesh)
+{
+	if (Mesh)
+	{
+		MeshEntries.Remove(TObjectKey<USkeletalMesh>(Mesh));
+	}
+}
+
+void FSocketResolutionCache::Reset()
+{
+	MeshEntries.Reset();
+}
+
+FSocketResolutionCache::FMeshEntry* FSocketResolutionCache::FindOrAddEntry(const USkeletalMeshComponent* MeshComponent)
+{
+	if (!MeshComponent)
+		return nullptr;
+
+	const USkeletalMesh* Mesh = MeshComponent->GetSkeletalMeshAsset();
+	if (!Mesh)
+		return nullptr;
+
+	const int32 NumBones = Mesh->GetRefSkeleton().GetNum();
+	TObjectKey<USkeletalMesh> Key(Mesh);
+
+	FMeshEntry* Entry = MeshEntries.Find(Key);
+	if (Entry && Entry->Mesh.Get() == Mesh && Entry->NumBones == NumBones)
+	{
+		return Entry;
+	}
+
+	// New mesh, or the skeleton changed since the entry was built
+	if (!Entry && MeshEntries.Num() >= PURGE_THRESHOLD)
+	{
+		PurgeStaleEntries();
+	}
+
+	FMeshEntry& NewEntry = MeshEntries.Add(Key);
+	NewEntry.Mesh = Mesh;
+	NewEntry.NumBones = NumBones;
+	return &NewEntry;
+}
+
+const FResolvedSocket& FSocketResolutionCache::ResolveInEntry(FMeshEntry& Entry, const USkeletalMesh* Mesh, FName SocketName)
+{
+	if (const FResolvedSocket* Existing = Entry.Sockets.Find(SocketName))
+	{
+		return *Existing;
+	}
+
+	FResolvedSocket Resolved;
+	Resolved.Name = SocketName;
+
+	if (Mesh && !SocketName.IsNone())
+	{
+		// Sockets first (same order as USkinnedMeshComponent::DoesSocketExist), then bones
+		FTransform SocketLocalTransform;
+		int32 SocketBoneIndex = INDEX_NONE;
+		int32 SocketIndex = INDEX_NONE;
+		if (Mesh->FindSocketInfo(SocketName, SocketLocalTransform, SocketBoneIndex, SocketIndex) && SocketBoneIndex != INDEX_NONE)
+		{
+			Resolved.BoneIndex = SocketBoneIndex;
+			Resolved.LocalTransform = SocketLocalTransform;
+		}
+		else
+		{
+			Resolved.BoneIndex = Mesh->GetRefSkeleton().FindBoneIndex(SocketName);
+		}
+	}
+
+	return Entry.Sockets.Add(SocketName, Resolved);
+}
+
+void FSocketResolutionCache::PurgeStaleEntries()
+{
+	for (auto It = MeshEntries.CreateIterator(); It; ++It)
+	{
+		if (!It.Value().Mesh.IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
@@ -0,0 +1,98 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+class USkeletalMesh;
+class USkeletalMeshComponent;
+
+/**
+ * Socket or bone resolved against a specific skeletal mesh asset
+ * World location becomes a bone transform fetch plus a fixed local offset
+ */
+struct SOUL_API FResolvedSocket
+{
+	/** Requested socket or bone name */
+	FName Name = NAME_None;
+
+	/** Bone index in the mesh reference skeleton, INDEX_NONE if the name did not resolve */
+	int32 BoneIndex = INDEX_NONE;
+
+	/** Socket transform relative to its bone (identity when the name is a bone) */
+	FTransform LocalTransform = FTransform::Identity;
+
+	bool IsValid() const { return BoneIndex != INDEX_NONE; }
+};
+
+/**
+ * Socket name resolution cache keyed by USkeletalMesh asset
+ * Resolves socket and bone names (and socket priority lists) once per mesh instead of
+ * searching the mesh by name on every camera and UI update.
+ * Because entries are keyed by the mesh asset, swapping the mesh on a component
+ * automatically selects a different entry; entries for destroyed or reimported meshes are dropped.
+ * Game thread only; returned pointers are only valid until the next call.
+ */
+struct SOUL_API FSocketResolutionCache
+{
+public:
+	/**
+	 * Resolve a single socket or bone name on the component's current mesh
+	 * @param MeshComponent Skeletal mesh component to resolve against
+	 * @param SocketName Socket or bone name
+	 * @return Resolved socket (check IsValid), or nullptr if the component has no mesh
+	 */
+	static const FResolvedSocket* Resolve(const USkeletalMeshComponent* MeshComponent, FName SocketName);
+
+	/**
+	 * Resolve the first available name of a priority list on the component's current mesh
+	 * The winning entry is memoized per mesh and per list
+	 * @param MeshComponent Skeletal mesh component to resolve against
+	 * @param SocketNames Socket names in priority order
+	 * @return First resolved socket, or nullptr if none of the names exist
+	 */
+	static const FResolvedSocket* ResolveFirst(const USkeletalMeshComponent* MeshComponent, const TArray<FName>& SocketNames);
+
+	/**
+	 * Get the world location of a resolved socket
+	 * @param MeshComponent Component the socket was resolved against
+	 * @param Socket Resolved socket
+	 * @return Socket world location
+	 */
+	static FVector GetSocketWorldLocation(const USkeletalMeshComponent* MeshComponent, const FResolvedSocket& Socket);
+
+	/** Drop every cached entry of a mesh (e.g. after its skeleton or sockets were edited) */
+	static void InvalidateMesh(const USkeletalMesh* Mesh);
+
+	/** Drop all cached entries */
+	static void Reset();
+
+private:
+	struct FMeshEntry
+	{
+		/** Mesh this entry was built for (detects destroyed meshes) */
+		TWeakObjectPtr<const USkeletalMesh> Mesh;
+
+		/** Bone count at resolution time (detects reimported skeletons) */
+		int32 NumBones = 0;
+
+		/** Resolved names, including names that did not resolve */
+		TMap<FName, FResolvedSocket> Sockets;
+
+		/** Winning name per priority list hash */
+		TMap<uint32, FName> FirstAvailableByList;
+	};
+
+	/** Find or (re)build the entry for a component's current mesh */
+	static FMeshEntry* FindOrAddEntry(const USkeletalMeshComponent* MeshComponent);
+
+	/** Resolve a name inside an entry */
+	static const FResolvedSocket& ResolveInEntry(FMeshEntry& Entry, const USkeletalMesh* Mesh, FName SocketName);
+
+	/** Remove entries whose mesh has been destroyed */
+	static void PurgeStaleEntries();
+
+	static TMap<TObjectKey<USkeletalMesh>, FMeshEntry> MeshEntries;
+
+	/** Purge stale entries once the cache grows past this many meshes */
+	static constexpr int32 PURGE_THRESHOLD = 64;
+};
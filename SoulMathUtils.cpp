@@ -5,6 +5,7 @@
 #include "Engine/World.h"
 #include "Components/PrimitiveComponent.h"
 #include "DrawDebugHelpers.h"
+#include "SocketResolutionCache.h"
 
 // ==================== Original MyCharacter Functions (Extracted) ====================
 
@@ -323,25 +324,24 @@ FVector USoulMathUtils::GetBestSocketLocation(AActor* TargetActor, const FSocket
 		return TargetActor->GetActorLocation() + SocketSettings.SocketOffset;
 	}
 
-	// Try primary socket first
-	if (SkeletalMesh->DoesSocketExist(SocketSettings.TargetSocketName))
+	// Try primary socket first (resolved once per mesh asset)
+	const FResolvedSocket* PrimarySocket = FSocketResolutionCache::Resolve(SkeletalMesh, SocketSettings.TargetSocketName);
+	if (PrimarySocket && PrimarySocket->IsValid())
 	{
-		FVector SocketLocation = SkeletalMesh->GetSocketLocation(SocketSettings.TargetSocketName);
+		FVector SocketLocation = FSocketResolutionCache::GetSocketWorldLocation(SkeletalMesh, *PrimarySocket);
 		return SocketLocation + SocketSettings.SocketOffset;
 	}
 
 	// Try alternative sockets if enabled
 	if (SocketSettings.bEnableSocketFallback)
 	{
-		for (const FName& SocketName : SocketSettings.SocketSearchNames)
+		const FResolvedSocket* FallbackSocket = FSocketResolutionCache::ResolveFirst(SkeletalMesh, SocketSettings.SocketSearchNames);
+		if (FallbackSocket)
 		{
-			if (SkeletalMesh->DoesSocketExist(SocketName))
-			{
-				FVector SocketLocation = SkeletalMesh->GetSocketLocation(SocketName);
-				UE_LOG(LogTemp, Log, TEXT("Using fallback socket '%s' for target '%s'"), 
-					*SocketName.ToString(), *TargetActor->GetName());
-				return SocketLocation + SocketSettings.SocketOffset;
-			}
+			FVector SocketLocation = FSocketResolutionCache::GetSocketWorldLocation(SkeletalMesh, *FallbackSocket);
+			UE_LOG(LogTemp, Log, TEXT("Using fallback socket '%s' for target '%s'"), 
+				*FallbackSocket->Name.ToString(), *TargetActor->GetName());
+			return SocketLocation + SocketSettings.SocketOffset;
 		}
 	}
 
@@ -360,15 +360,8 @@ FName USoulMathUtils::FindFirstAvailableSocket(AActor* TargetActor, const TArray
 	if (!SkeletalMesh)
 		return NAME_None;
 
-	for (const FName& SocketName : SocketNames)
-	{
-		if (SkeletalMesh->DoesSocketExist(SocketName))
-		{
-			return SocketName;
-		}
-	}
-
-	return NAME_None;
+	const FResolvedSocket* Resolved = FSocketResolutionCache::ResolveFirst(SkeletalMesh, SocketNames);
+	return Resolved ? Resolved->Name : NAME_None;
 }
 
 float USoulMathUtils::GetDistanceBasedCameraSpeedMultiplier(float Distance, const FAdvancedCameraSettings& Settings)
@@ -0,0 +1,140 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SoulPlayerCameraManager.h"
+#include "CameraControlComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/SpringArmComponent.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/World.h"
+#include "Kismet/KismetMathLibrary.h"
+
+void ASoulPlayerCameraManager::InitializeFor(APlayerController* PC)
+{
+	Super::InitializeFor(PC);
+
+	BindLateLatch();
+}
+
+void ASoulPlayerCameraManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UnbindLateLatch();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ASoulPlayerCameraManager::UpdateViewTarget(FTViewTarget& OutVT, float DeltaTime)
+{
+	Super::UpdateViewTarget(OutVT, DeltaTime);
+
+	bLateLatchPending = false;
+
+	UCameraControlComponent* CameraControl = FindCameraControl(OutVT.Target);
+	if (!CameraControl || !CameraControl->IsLateLockOnSolveActive() || !PCOwner)
+		return;
+
+	// 弹簧臂本帧使用的旋转（求解前的控制器旋转，含旋转延迟）
+	const USpringArmComponent* SpringArm = OutVT.Target->FindComponentByClass<USpringArmComponent>();
+	const FQuat ArmRotation = SpringArm ? SpringArm->GetSocketQuaternion(USpringArmComponent::SocketName) : OutVT.POV.Rotation.Quaternion();
+	const FVector Pivot = SpringArm ? SpringArm->GetComponentLocation() + SpringArm->TargetOffset : OutVT.POV.Location;
+
+	if (!CameraControl->SolveLateLockOnCamera())
+		return;
+
+	// 把求解结果叠加到视图上（保留相机相对弹簧臂的旋转与镜头抖动等修改器的偏移）
+	const FQuat SolvedRotation = PCOwner->GetControlRotation().Quaternion();
+	const FRotator NewRotation = (SolvedRotation * ArmRotation.Inverse() * OutVT.POV.Rotation.Quaternion()).Rotator();
+	ReaimView(OutVT.POV, Pivot, NewRotation);
+
+	// 记录延迟锁存的比较基准
+	AActor* Target = CameraControl->GetCurrentLockOnTarget();
+	if (bEnableLateLatch && Target)
+	{
+		LateLatchTarget = Target;
+		LateLatchAimPoint = CameraControl->GetOptimalLockOnPosition(Target);
+		LateLatchPlayerLocation = OutVT.Target->GetActorLocation();
+		LateLatchPivot = Pivot;
+		bLateLatchPending = true;
+	}
+}
+
+UCameraControlComponent* ASoulPlayerCameraManager::FindCameraControl(AActor* ViewTargetActor)
+{
+	if (!ViewTargetActor)
+		return nullptr;
+
+	if (CachedViewTarget.Get() != ViewTargetActor)
+	{
+		CachedViewTarget = ViewTargetActor;
+		CachedCameraControl = ViewTargetActor->FindComponentByClass<UCameraControlComponent>();
+	}
+
+	return CachedCameraControl.Get();
+}
+
+void ASoulPlayerCameraManager::ReaimView(FMinimalViewInfo& POV, const FVector& Pivot, const FRotator& NewRotation)
+{
+	const FQuat Delta = NewRotation.Quaternion() * POV.Rotation.Quaternion().Inverse();
+	POV.Location = Pivot + Delta.RotateVector(POV.Location - Pivot);
+	POV.Rotation = NewRotation;
+}
+
+void ASoulPlayerCameraManager::HandleViewportBeginDraw()
+{
+	if (!bLateLatchPending)
+		return;
+
+	bLateLatchPending = false;
+
+	if (!bEnableLateLatch || !PCOwner || !PCOwner->IsLocalController())
+		return;
+
+	UCameraControlComponent* CameraControl = CachedCameraControl.Get();
+	AActor* Target = LateLatchTarget.Get();
+	AActor* ViewTargetActor = CachedViewTarget.Get();
+	if (!CameraControl || !Target || !ViewTargetActor || CameraControl->GetCurrentLockOnTarget() != Target)
+		return;
+
+	// 相机更新之后目标或玩家仍可能被移动（定时器、延迟的物理或动画结果）
+	const FVector PlayerLocation = ViewTargetActor->GetActorLocation();
+	const FVector AimPoint = CameraControl->GetOptimalLockOnPosition(Target);
+	if (AimPoint.Equals(LateLatchAimPoint, 0.1f) && PlayerLocation.Equals(LateLatchPlayerLocation, 0.1f))
+		return;
+
+	FRotator Correction = (UKismetMathLibrary::FindLookAtRotation(PlayerLocation, AimPoint)
+		- UKismetMathLibrary::FindLookAtRotation(LateLatchPlayerLocation, LateLatchAimPoint)).GetNormalized();
+	Correction.Pitch = FMath::Clamp(Correction.Pitch, -LateLatchMaxCorrection, LateLatchMaxCorrection);
+	Correction.Yaw = FMath::Clamp(Correction.Yaw, -LateLatchMaxCorrection, LateLatchMaxCorrection);
+	Correction.Roll = 0.0f;
+
+	if (Correction.IsNearlyZero(0.01f))
+		return;
+
+	// 只修正本帧的相机缓存，控制器旋转由下一帧的求解自然追上
+	FMinimalViewInfo POV = GetCameraCacheView();
+	ReaimView(POV, LateLatchPivot, (POV.Rotation + Correction).GetNormalized());
+	FillCameraCache(POV);
+}
+
+void ASoulPlayerCameraManager::BindLateLatch()
+{
+	UnbindLateLatch();
+
+	UWorld* World = GetWorld();
+	UGameViewportClient* Viewport = World ? World->GetGameViewport() : nullptr;
+	if (!Viewport)
+		return;
+
+	BeginDrawHandle = Viewport->OnBeginDraw().AddUObject(this, &ASoulPlayerCameraManager::HandleViewportBeginDraw);
+	BoundViewport = Viewport;
+}
+
+void ASoulPlayerCameraManager::UnbindLateLatch()
+{
+	if (UGameViewportClient* Viewport = BoundViewport.Get())
+	{
+		Viewport->OnBeginDraw().Remove(BeginDrawHandle);
+	}
+
+	BeginDrawHandle.Reset();
+	BoundViewport.Reset();
+}
@@ -0,0 +1,65 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Camera/PlayerCameraManager.h"
+#include "SoulPlayerCameraManager.generated.h"
+
+class UCameraControlComponent;
+class UGameViewportClient;
+
+/**
+ * 锁定相机管理器
+ * 在UpdateViewTarget中执行锁定朝向求解：此时所有Actor的移动与动画都已完成，使用的是本帧最终的目标Socket位置，
+ * 避免组件Tick中求解带来的一帧滞后；求解出的旋转同时写回控制器并直接修正本帧视图。
+ * 可选的延迟锁存在视口开始绘制前再根据目标最新位置做一次小幅修正（不写回控制器）。
+ *
+ * 使用方式：把玩家控制器的PlayerCameraManagerClass设为本类；未使用时UCameraControlComponent回退到Tick求解。
+ */
+UCLASS()
+class SOUL_API ASoulPlayerCameraManager : public APlayerCameraManager
+{
+	GENERATED_BODY()
+
+public:
+	virtual void InitializeFor(APlayerController* PC) override;
+
+	/** 是否在绘制前做延迟锁存修正 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lock On Camera")
+	bool bEnableLateLatch = true;
+
+	/** 延迟锁存单次修正的最大角度（度） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lock On Camera", meta = (ClampMin = "0.0", ClampMax = "30.0"))
+	float LateLatchMaxCorrection = 5.0f;
+
+protected:
+	virtual void UpdateViewTarget(FTViewTarget& OutVT, float DeltaTime) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	/** 获取视图目标上的相机控制组件（按视图目标缓存） */
+	UCameraControlComponent* FindCameraControl(AActor* ViewTargetActor);
+
+	/** 以Pivot为中心把视图旋转到NewRotation（保持相机臂长度与碰撞缩短后的距离） */
+	static void ReaimView(FMinimalViewInfo& POV, const FVector& Pivot, const FRotator& NewRotation);
+
+	/** 视口开始绘制：根据目标最新位置修正相机缓存 */
+	void HandleViewportBeginDraw();
+
+	void BindLateLatch();
+	void UnbindLateLatch();
+
+	TWeakObjectPtr<AActor> CachedViewTarget;
+	TWeakObjectPtr<UCameraControlComponent> CachedCameraControl;
+
+	/** 本帧延迟求解时的状态（供延迟锁存比较） */
+	TWeakObjectPtr<AActor> LateLatchTarget;
+	FVector LateLatchAimPoint = FVector::ZeroVector;
+	FVector LateLatchPlayerLocation = FVector::ZeroVector;
+	FVector LateLatchPivot = FVector::ZeroVector;
+	bool bLateLatchPending = false;
+
+	FDelegateHandle BeginDrawHandle;
+	TWeakObjectPtr<UGameViewportClient> BoundViewport;
+};
@@ -0,0 +1,33 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SoulTrace.h"
+#include "HAL/IConsoleManager.h"
+
+UE_TRACE_CHANNEL_DEFINE(SoulLockOnChannel);
+
+TRACE_DECLARE_INT_COUNTER(SoulLockOn_Candidates, TEXT("SoulLockOn/Candidates"));
+TRACE_DECLARE_INT_COUNTER(SoulLockOn_TracesIssued, TEXT("SoulLockOn/TracesIssued"));
+TRACE_DECLARE_INT_COUNTER(SoulLockOn_ActiveWidgets, TEXT("SoulLockOn/ActiveWidgets"));
+
+#if UE_TRACE_ENABLED
+
+static FAutoConsoleCommand CmdSoulTraceLockOn(
+	TEXT("Soul.Trace.LockOn"),
+	TEXT("Toggle the SoulLockOn Unreal Insights channel (lock-on CPU scopes and counters): Soul.Trace.LockOn [0|1]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const bool bEnable = Args.Num() > 0 ? FCString::ToBool(*Args[0]) : !UE_TRACE_CHANNELEXPR_IS_ENABLED(SoulLockOnChannel);
+
+		// 作用域事件与计数器分别依赖Cpu与Counters通道
+		if (bEnable)
+		{
+			UE::Trace::ToggleChannel(TEXT("Cpu"), true);
+			UE::Trace::ToggleChannel(TEXT("Counters"), true);
+		}
+		UE::Trace::ToggleChannel(TEXT("SoulLockOn"), bEnable);
+
+		UE_LOG(LogTemp, Log, TEXT("SoulLockOn trace channel %s"), UE_TRACE_CHANNELEXPR_IS_ENABLED(SoulLockOnChannel) ? TEXT("enabled") : TEXT("disabled"));
+	})
+);
+
+#endif // UE_TRACE_ENABLED
@@ -0,0 +1,40 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CountersTrace.h"
+
+/**
+ * SoulLockOn追踪通道
+ * 锁定系统的CPU事件（SOUL_PERFORMANCE_SCOPE）与计数器输出到Unreal Insights，与GC、物理、渲染在同一时间线上对比。
+ * 通道默认关闭，关闭时每个作用域只做一次通道检查；UPerformanceProfiler的游戏内统计不受影响。
+ *
+ * 启动参数：-trace=cpu,counters,SoulLockOn
+ * 控制台：Soul.Trace.LockOn [0|1]（等价于 Trace.Enable SoulLockOn，开启时同时打开Cpu与Counters通道）
+ */
+UE_TRACE_CHANNEL_EXTERN(SoulLockOnChannel, SOUL_API);
+
+/** 所有目标检测组件的锁定候选总数 */
+TRACE_DECLARE_INT_COUNTER_EXTERN(SoulLockOn_Candidates);
+
+/** 上一帧所有目标检测组件发出的视线检测数 */
+TRACE_DECLARE_INT_COUNTER_EXTERN(SoulLockOn_TracesIssued);
+
+/** 当前显示中的锁定UI数 */
+TRACE_DECLARE_INT_COUNTER_EXTERN(SoulLockOn_ActiveWidgets);
+
+/** SoulLockOn通道开启时设置计数器（Value只在通道开启时求值） */
+#if COUNTERSTRACE_ENABLED
+#define SOUL_TRACE_COUNTER_SET(CounterName, Value) \
+	do \
+	{ \
+		if (UE_TRACE_CHANNELEXPR_IS_ENABLED(SoulLockOnChannel)) \
+		{ \
+			TRACE_COUNTER_SET(CounterName, Value); \
+		} \
+	} while (0)
+#else
+#define SOUL_TRACE_COUNTER_SET(CounterName, Value)
+#endif
@@ -3,6 +3,7 @@
 #include "StaminaComponent.h"
 #include "Engine/World.h"
 #include "TimerManager.h"
+#include "CombatStatsSubsystem.h"
 
 // ���캯��
 UStaminaComponent::UStaminaComponent()
@@ -41,13 +42,39 @@ void UStaminaComponent::BeginPlay()
 		StaminaRecoveryStartTime = LastStaminaUseTime;
 	}
 
+	// 注册到战斗数值子系统，由其集中处理恢复
+	if (bUseCombatStatsSubsystem)
+	{
+		UCombatStatsSubsystem* Subsystem = GetWorld() ? GetWorld()->GetSubsystem<UCombatStatsSubsystem>() : nullptr;
+		if (Subsystem)
+		{
+			CombatStats = Subsystem;
+			CombatStatsSlot = Subsystem->RegisterStamina(this);
+			SetComponentTickEnabled(false);
+		}
+	}
+
 	// ������ʼ�¼�
-	TriggerStaminaChangedEvent();
+	StaminaChangedEvent.Reset();
+	TriggerStaminaChangedEvent(true);
 
 	UE_LOG(LogTemp, Warning, TEXT("StaminaComponent: BeginPlay completed. Current stamina: %.1f/%.1f"), 
 		CurrentStamina, StaminaSettings.MaxStamina);
 }
 
+// 游戏结束时调用
+void UStaminaComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UCombatStatsSubsystem* Subsystem = CombatStats.Get())
+	{
+		Subsystem->UnregisterStamina(CombatStatsSlot);
+	}
+	CombatStats.Reset();
+	CombatStatsSlot = INDEX_NONE;
+
+	Super::EndPlay(EndPlayReason);
+}
+
 // ÿ֡����
 void UStaminaComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
@@ -58,6 +85,9 @@ void UStaminaComponent::TickComponent(float DeltaTime, ELevelTick TickType, FAct
 	{
 		UpdateStaminaRecovery(DeltaTime);
 	}
+
+	// 本帧累积的精力变化最多广播一次
+	FlushStaminaChangedEvent();
 }
 
 // ==================== ���ľ��������ӿ�ʵ�� ====================
@@ -175,7 +205,7 @@ void UStaminaComponent::ResetStamina()
 	bIsRecoveringStamina = false;
 
 	// �����¼�
-	TriggerStaminaChangedEvent();
+	TriggerStaminaChangedEvent(true);
 	OnStaminaFullyRecovered.Broadcast();
 
 	UE_LOG(LogTemp, Log, TEXT("StaminaComponent: Stamina reset. %.1f -> %.1f"), OldStamina, CurrentStamina);
@@ -197,6 +227,8 @@ void UStaminaComponent::SetStaminaRecoveryEnabled(bool bEnabled)
 
 	UE_LOG(LogTemp, Log, TEXT("StaminaComponent: Stamina recovery %s"), 
 		bEnabled ? TEXT("enabled") : TEXT("disabled"));
+
+	PushCombatStats();
 }
 
 // ==================== ״̬��ѯ�ӿ�ʵ�� ====================
@@ -231,7 +263,7 @@ void UStaminaComponent::SetStaminaSettings(const FStaminaSettings& NewSettings)
 	ClampStaminaValue();
 
 	// �����¼�
-	TriggerStaminaChangedEvent();
+	TriggerStaminaChangedEvent(true);
 
 	UE_LOG(LogTemp, Log, TEXT("StaminaComponent: Settings updated. New MaxStamina: %.1f, Current: %.1f"), 
 		StaminaSettings.MaxStamina, CurrentStamina);
@@ -256,7 +288,7 @@ void UStaminaComponent::SetMaxStamina(float NewMaxStamina)
 	ClampStaminaValue();
 
 	// �����¼�
-	TriggerStaminaChangedEvent();
+	TriggerStaminaChangedEvent(true);
 
 	UE_LOG(LogTemp, Log, TEXT("StaminaComponent: Max stamina updated to %.1f, Current: %.1f"), 
 		NewMaxStamina, CurrentStamina);
@@ -286,18 +318,8 @@ void UStaminaComponent::UpdateStaminaRecovery(float DeltaTime)
 		return;
 	}
 
-	// ��ʼ�ָ��������û��ʼ��
-	if (!bIsRecoveringStamina)
-	{
-		bIsRecoveringStamina = true;
-		StaminaRecoveryStartTime = CurrentTime;
-		
-		// ����״̬Ϊ�ָ���
-		if (CurrentStaminaState != EStaminaState::Recovering && CurrentStaminaState != EStaminaState::Normal)
-		{
-			UpdateStaminaState(EStaminaState::Recovering);
-		}
-	}
+	// 开始恢复（如果还没开始）
+	BeginStaminaRecovery(CurrentTime);
 
 	// ����ָ���
 	float RecoveryRate = GetCurrentRecoveryRate();
@@ -310,6 +332,53 @@ void UStaminaComponent::UpdateStaminaRecovery(float DeltaTime)
 	}
 }
 
+void UStaminaComponent::BeginStaminaRecovery(float CurrentTime)
+{
+	if (bIsRecoveringStamina)
+	{
+		return;
+	}
+
+	bIsRecoveringStamina = true;
+	StaminaRecoveryStartTime = CurrentTime;
+
+	// 耗尽或过度疲劳时切换为恢复中
+	if (CurrentStaminaState != EStaminaState::Recovering && CurrentStaminaState != EStaminaState::Normal)
+	{
+		UpdateStaminaState(EStaminaState::Recovering);
+	}
+}
+
+void UStaminaComponent::ApplyCombatStats(float RecoveredStamina)
+{
+	if (RecoveredStamina > CurrentStamina)
+	{
+		if (UWorld* World = GetWorld())
+		{
+			BeginStaminaRecovery(World->GetTimeSeconds());
+		}
+		RecoverStamina(RecoveredStamina - CurrentStamina);
+	}
+
+	FlushStaminaChangedEvent();
+
+	// 组件上的值才是最终结果，写回共享缓冲
+	PushCombatStats();
+}
+
+void UStaminaComponent::PushCombatStats()
+{
+	UCombatStatsSubsystem* Subsystem = CombatStats.Get();
+	if (!Subsystem)
+	{
+		return;
+	}
+
+	const float RecoveryRate = bStaminaRecoveryEnabled ? GetCurrentRecoveryRate() : 0.0f;
+	Subsystem->UpdateStamina(CombatStatsSlot, CurrentStamina, StaminaSettings.MaxStamina, RecoveryRate,
+		LastStaminaUseTime + StaminaSettings.StaminaRecoveryDelay);
+}
+
 float UStaminaComponent::GetActionStaminaCost(EStaminaAction Action) const
 {
 	switch (Action)
@@ -342,6 +411,9 @@ void UStaminaComponent::UpdateStaminaState(EStaminaState NewState)
 	EStaminaState OldState = CurrentStaminaState;
 	CurrentStaminaState = NewState;
 
+	// 过度疲劳会改变恢复速率
+	PushCombatStats();
+
 	// ����״̬�仯�¼�
 	OnStaminaStateChanged.Broadcast(OldState, NewState);
 
@@ -349,8 +421,33 @@ void UStaminaComponent::UpdateStaminaState(EStaminaState NewState)
 		(int32)OldState, (int32)NewState);
 }
 
-void UStaminaComponent::TriggerStaminaChangedEvent()
+void UStaminaComponent::TriggerStaminaChangedEvent(bool bForce)
+{
+	PushCombatStats();
+
+	// 耗尽/回满等离散变化立即广播，其余变化留到Tick末尾合并
+	if (StaminaChangedEvent.MarkChanged(CurrentStamina, StaminaSettings.MaxStamina, bForce))
+	{
+		BroadcastStaminaChanged();
+	}
+	else if (UCombatStatsSubsystem* Subsystem = CombatStats.Get())
+	{
+		// 组件不再Tick，由子系统在帧末回调发布
+		Subsystem->MarkStaminaDirty(CombatStatsSlot);
+	}
+}
+
+void UStaminaComponent::FlushStaminaChangedEvent()
+{
+	if (StaminaChangedEvent.ConsumePending(CurrentStamina, ChangeEventQuantizationStep))
+	{
+		BroadcastStaminaChanged();
+	}
+}
+
+void UStaminaComponent::BroadcastStaminaChanged()
 {
+	StaminaChangedEvent.MarkPublished(CurrentStamina);
 	OnStaminaChanged.Broadcast(CurrentStamina, StaminaSettings.MaxStamina);
 }
 
@@ -5,8 +5,11 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "Engine/Engine.h"
+#include "CoalescedValueEvent.h"
 #include "StaminaComponent.generated.h"
 
+class UCombatStatsSubsystem;
+
 // ����״̬ö��
 UENUM(BlueprintType)
 enum class EStaminaState : uint8
@@ -116,6 +119,9 @@ protected:
 	// ��Ϸ��ʼʱ����
 	virtual void BeginPlay() override;
 
+	// 游戏结束时调用
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 public:	
 	// ÿ֡����
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
@@ -233,6 +239,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Stamina")
 	void SetMaxStamina(float NewMaxStamina);
 
+	// ==================== 共享数值 ====================
+
+	/**
+	 * 由战斗数值子系统回调：应用共享缓冲中积分后的精力并发布待定事件
+	 * @param RecoveredStamina 子系统积分后的精力值
+	 */
+	void ApplyCombatStats(float RecoveredStamina);
+
 	// ==================== �¼�ί�� ====================
 
 	// �����仯�¼�
@@ -258,6 +272,14 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stamina Settings")
 	FStaminaSettings StaminaSettings;
 
+	// 精力变化事件的量化步长（连续恢复时只有跨过步长边界才广播，0表示每帧有变化就广播）
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stamina Events", meta = (ClampMin = "0.0", ClampMax = "25.0"))
+	float ChangeEventQuantizationStep = 1.0f;
+
+	// 由战斗数值子系统集中处理恢复（组件自身不再Tick）
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stamina Settings")
+	bool bUseCombatStatsSubsystem = true;
+
 	// ==================== ����ʱ״̬ ====================
 
 	// ��ǰ����ֵ
@@ -285,6 +307,13 @@ protected:
 	// ����ƣ�ͼ�����
 	int32 ExhaustedCounter;
 
+	// 精力变化事件的合并状态
+	FCoalescedValueEvent StaminaChangedEvent;
+
+	// 战斗数值子系统及在其中的槽位（未注册时为INDEX_NONE）
+	TWeakObjectPtr<UCombatStatsSubsystem> CombatStats;
+	int32 CombatStatsSlot = INDEX_NONE;
+
 private:
 	// ==================== ˽�и������� ====================
 
@@ -310,7 +339,17 @@ private:
 	/**
 	 * ���������仯�¼�
 	 */
-	void TriggerStaminaChangedEvent();
+	void TriggerStaminaChangedEvent(bool bForce = false);
+
+	/**
+	 * 发布本帧合并后的精力变化事件（Tick末尾调用）
+	 */
+	void FlushStaminaChangedEvent();
+
+	/**
+	 * 广播精力变化事件并记录已发布的值
+	 */
+	void BroadcastStaminaChanged();
 
 	/**
 	 * ��鲢���������ľ�״̬
@@ -332,4 +371,14 @@ private:
 	 * ��֤����ֵ��Χ
 	 */
 	void ClampStaminaValue();
+
+	/**
+	 * 进入恢复阶段（首次恢复时更新状态与开始时间）
+	 */
+	void BeginStaminaRecovery(float CurrentTime);
+
+	/**
+	 * 把当前精力与恢复参数推送到战斗数值子系统
+	 */
+	void PushCombatStats();
 };
\ No newline at end of file
@@ -10,6 +10,14 @@
 #include "Components/SkeletalMeshComponent.h"
 #include "GameFramework/Pawn.h"
 #include "EngineUtils.h"
+#include "DebugManager.h"
+#include "Tasks/Task.h"
+#include "LockOnCandidateSubsystem.h"
+#include "Misc/App.h"
+#include "UObject/UObjectIterator.h"
+#include "Engine/Engine.h"
+#include "Engine/LocalPlayer.h"
+#include "CameraControlComponent.h"
 
 UTargetDetectionComponent::UTargetDetectionComponent()
 {
@@ -23,6 +31,10 @@ UTargetDetectionComponent::UTargetDetectionComponent()
 	// �������
 	LockOnCandidates.Empty();
 	EnemySizeCache.Empty();
+
+	FrontScoringResult = MakeShared<FTargetScoringResult>();
+	BackScoringResult = MakeShared<FTargetScoringResult>();
+	ScoringInput = MakeShared<FTargetScoringInput>();
 	
 	UE_LOG(LogTemp, Log, TEXT("TargetDetectionComponent: Initialized"));
 }
@@ -30,10 +42,38 @@ UTargetDetectionComponent::UTargetDetectionComponent()
 void UTargetDetectionComponent::BeginPlay()
 {
 	Super::BeginPlay();
+
+	// 分屏时多个玩家共享一次候选收集
+	if (ULockOnCandidateSubsystem* Subsystem = GetWorld()->GetSubsystem<ULockOnCandidateSubsystem>())
+	{
+		Subsystem->RegisterDetector(this);
+		SharedCandidates = Subsystem;
+	}
 	
 	UE_LOG(LogTemp, Warning, TEXT("TargetDetectionComponent: BeginPlay called"));
 }
 
+void UTargetDetectionComponent::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+
+	// 计入memreport的obj list
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(EnemySizeCache.GetAllocatedSize() + CandidateLODCache.GetAllocatedSize() + PrefilterInViewportCache.GetAllocatedSize());
+}
+
+void UTargetDetectionComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	WaitForTargetScoring();
+
+	if (ULockOnCandidateSubsystem* Subsystem = SharedCandidates.Get())
+	{
+		Subsystem->UnregisterDetector(this);
+	}
+	SharedCandidates.Reset();
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void UTargetDetectionComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
@@ -45,20 +85,31 @@ void UTargetDetectionComponent::TickComponent(float DeltaTime, ELevelTick TickTy
 
 	float CurrentTime = GetWorld()->GetTimeSeconds();
 
+	// 上一帧派发的评分任务完成后发布结果
+	if (bAsyncTargetScoring)
+	{
+		ConsumeTargetScoring();
+	}
+
 	// ���ڲ��ҿ�����Ŀ��
 	if (CurrentTime - LastTargetSearchTime > TARGET_SEARCH_INTERVAL)
 	{
-		FindLockOnCandidates();
+		SOUL_PERFORMANCE_SCOPE(TEXT("TargetDetection::TargetSearch"));
+
+		if (bAsyncTargetScoring)
+		{
+			DispatchTargetScoring();
+		}
+		else
+		{
+			FindLockOnCandidates();
+		}
 		LastTargetSearchTime = CurrentTime;
 
 		// ��Ƶ��־�Ż� - ���ӽ�Ƶ����
 		if (bEnableTargetDetectionDebugLogs)
 		{
-			static int32 FrameCounter = 0;
-			if (++FrameCounter % 300 == 0) // ÿ5��ֻ��¼һ�Σ�60fps * 5��
-			{
-				UE_LOG(LogTemp, Verbose, TEXT("TargetDetectionComponent: Target search completed, found %d candidates"), LockOnCandidates.Num());
-			}
+			SOUL_LOG_VERBOSE_RATE_LIMITED(TargetDetection, 5.0, TEXT("Target search completed, found %d candidates"), LockOnCandidates.Num());
 		}
 	}
 
@@ -71,11 +122,7 @@ void UTargetDetectionComponent::TickComponent(float DeltaTime, ELevelTick TickTy
 		// ��Ƶ��־�Ż� - ���ӽ�Ƶ����
 		if (bEnableSizeAnalysisDebugLogs)
 		{
-			static int32 SizeFrameCounter = 0;
-			if (++SizeFrameCounter % 300 == 0) // ÿ5��ֻ��¼һ��
-			{
-				UE_LOG(LogTemp, Verbose, TEXT("TargetDetectionComponent: Size cache updated, tracking %d enemies"), EnemySizeCache.Num());
-			}
+			SOUL_LOG_VERBOSE_RATE_LIMITED(TargetDetection, 5.0, TEXT("Size cache updated, tracking %d enemies"), EnemySizeCache.Num());
 		}
 	}
 }
@@ -96,6 +143,38 @@ void UTargetDetectionComponent::SetLockOnDetectionSphere(USphereComponent* Detec
 	}
 }
 
+void UTargetDetectionComponent::SetLockOnSettings(const FLockOnSettings& Settings)
+{
+	LockOnSettings = Settings;
+
+	if (LockOnDetectionSphere)
+	{
+		LockOnDetectionSphere->SetSphereRadius(LockOnSettings.LockOnRange);
+	}
+
+	// 没有拥有者分发时下次读取按新配置重建
+	CompiledSettings.Reset();
+	OnLockOnSettingsChanged.Broadcast();
+}
+
+void UTargetDetectionComponent::SetCompiledSettings(TSharedPtr<const FCompiledLockOnSettings> InCompiledSettings)
+{
+	CompiledSettings = InCompiledSettings;
+}
+
+const FCompiledLockOnSettings& UTargetDetectionComponent::GetCompiledSettings() const
+{
+	// 未由拥有者分发时，按本组件的锁定设置与拥有者相机控制组件的相机设置构建一次
+	if (!CompiledSettings.IsValid())
+	{
+		const UCameraControlComponent* CameraControl = GetOwner() ? GetOwner()->FindComponentByClass<UCameraControlComponent>() : nullptr;
+		CompiledSettings = FCompiledLockOnSettings::Build(LockOnSettings,
+			CameraControl ? CameraControl->CameraSettings : FCameraSettings(),
+			CameraControl ? CameraControl->AdvancedCameraSettings : FAdvancedCameraSettings());
+	}
+	return *CompiledSettings;
+}
+
 EEnemySizeCategory UTargetDetectionComponent::GetTargetSizeCategory(AActor* Target)
 {
 	if (!Target)
@@ -131,47 +210,17 @@ void UTargetDetectionComponent::FindLockOnCandidates()
 		return;
 	}
 
-	// ����ϴεĺ�ѡ�б�
-	LockOnCandidates.Empty();
-
-	// ��ȡ���巶Χ�ڵ������ص�Actor
-	TArray<AActor*> OverlappingActors;
-	LockOnDetectionSphere->GetOverlappingActors(OverlappingActors, APawn::StaticClass());
-
-	// ��ʱ�洢��ЧĿ��
-	TArray<AActor*> ValidTargets;
-	
-	for (AActor* Actor : OverlappingActors)
-	{
-		if (IsValidLockOnTarget(Actor))
-		{
-			ValidTargets.Add(Actor);
-		}
-	}
-
-	// ���Ƕ�������ЧĿ�� - ������
-	if (ValidTargets.Num() > 1)
-	{
-		SortCandidatesByDirection(ValidTargets);
-	}
+	// 同步路径（锁定输入需要立即结果）：先等待进行中的任务，再在游戏线程直接评分并发布
+	WaitForTargetScoring();
 
-	// ��������Ŀ�����ӵ���ѡ�б�
-	LockOnCandidates = ValidTargets;
-
-	// ����Ŀ������¼�
-	if (OnTargetsUpdated.IsBound())
-	{
-		OnTargetsUpdated.Broadcast(LockOnCandidates);
-	}
+	GatherScoringInput(*ScoringInput);
+	BackScoringResult->Build(*ScoringInput);
+	Swap(FrontScoringResult, BackScoringResult);
+	PublishScoringResult();
 
-	// ��Ƶ��־�Ż� - ���ӽ�Ƶ����
 	if (bEnableTargetDetectionDebugLogs)
 	{
-		static int32 FindFrameCounter = 0;
-		if (++FindFrameCounter % 120 == 0) // ÿ2��ֻ��¼һ��
-		{
-			UE_LOG(LogTemp, Verbose, TEXT("TargetDetectionComponent: Lock-on candidates updated: %d targets available"), LockOnCandidates.Num());
-		}
+		SOUL_LOG_VERBOSE_RATE_LIMITED(TargetDetection, 2.0, TEXT("Lock-on candidates updated: %d targets available"), LockOnCandidates.Num());
 	}
 }
 
@@ -192,8 +241,8 @@ bool UTargetDetectionComponent::IsValidLockOnTarget(AActor* Target)
 	FVector TargetLocation = Target->GetActorLocation();
 
 	// ������
-	float Distance = FVector::Dist(PlayerLocation, TargetLocation);
-	if (Distance > LockOnSettings.LockOnRange)
+	float DistanceSquared = FVector::DistSquared(PlayerLocation, TargetLocation);
+	if (DistanceSquared > GetCompiledSettings().LockOnRangeSquared)
 	{
 		return false;
 	}
@@ -224,10 +273,9 @@ bool UTargetDetectionComponent::IsTargetStillLockable(AActor* Target)
 	FVector TargetLocation = Target->GetActorLocation();
 
 	// ʹ�ø���ľ��뷶Χ����������
-	float Distance = FVector::Dist(PlayerLocation, TargetLocation);
-	float ExtendedLockOnRange = LockOnSettings.LockOnRange * LockOnSettings.ExtendedLockRangeMultiplier;
+	float DistanceSquared = FVector::DistSquared(PlayerLocation, TargetLocation);
 	
-	if (Distance > ExtendedLockOnRange)
+	if (DistanceSquared > GetCompiledSettings().ExtendedLockOnRangeSquared)
 	{
 		return false;
 	}
@@ -271,43 +319,10 @@ AActor* UTargetDetectionComponent::GetBestTargetFromList(const TArray<AActor*>&
 
 AActor* UTargetDetectionComponent::GetBestSectorLockTarget()
 {
+	// 同步刷新后直接读取本次的评分结果
 	FindLockOnCandidates();
 
-	if (LockOnCandidates.Num() == 0)
-		return nullptr;
-
-	// ���ȳ���������������������Ŀ��
-	TArray<AActor*> SectorTargets;
-	TArray<AActor*> EdgeTargets;
-
-	for (AActor* Candidate : LockOnCandidates)
-	{
-		if (!Candidate)
-			continue;
-			
-		if (IsTargetInSectorLockZone(Candidate))
-		{
-			SectorTargets.Add(Candidate);
-		}
-		else if (IsTargetInEdgeDetectionZone(Candidate))
-		{
-			EdgeTargets.Add(Candidate);
-		}
-	}
-
-	// ���ȴ�����������ѡ��Ŀ��
-	if (SectorTargets.Num() > 0)
-	{
-		return GetBestTargetFromList(SectorTargets);
-	}
-
-	// �������������û��Ŀ�꣬����Ե����
-	if (EdgeTargets.Num() > 0)
-	{
-		return GetBestTargetFromList(EdgeTargets);
-	}
-
-	return nullptr;
+	return GetCachedBestSectorLockTarget();
 }
 
 AActor* UTargetDetectionComponent::TryGetSectorLockTarget()
@@ -315,28 +330,25 @@ AActor* UTargetDetectionComponent::TryGetSectorLockTarget()
 	if (LockOnCandidates.Num() == 0)
 		return nullptr;
 
-	// ɸѡ���������ڵ�Ŀ��
-	TArray<AActor*> SectorTargets;
-	
-	for (AActor* Candidate : LockOnCandidates)
+	// 扇区内得分最高的目标已在评分时求出
+	AActor* SectorTarget = GetScoredActor(FrontScoringResult->BestSectorIndex);
+	if (SectorTarget && bEnableTargetDetectionDebugLogs)
 	{
-		if (Candidate && IsTargetInSectorLockZone(Candidate))
-		{
-			SectorTargets.Add(Candidate);
-		}
+		UE_LOG(LogTemp, Warning, TEXT("TargetDetectionComponent: Found sector lock target %s"), *SectorTarget->GetName());
 	}
 
-	// ���������������Ŀ�꣬�������Ŀ��
-	if (SectorTargets.Num() > 0)
+	return SectorTarget;
+}
+
+AActor* UTargetDetectionComponent::GetCachedBestSectorLockTarget() const
+{
+	// 优先扇区，其次边缘区域
+	if (AActor* SectorTarget = GetScoredActor(FrontScoringResult->BestSectorIndex))
 	{
-		if (bEnableTargetDetectionDebugLogs)
-		{
-			UE_LOG(LogTemp, Warning, TEXT("TargetDetectionComponent: Found %d targets in sector lock zone"), SectorTargets.Num());
-		}
-		return GetBestTargetFromList(SectorTargets);
+		return SectorTarget;
 	}
 
-	return nullptr;
+	return GetScoredActor(FrontScoringResult->BestEdgeIndex);
 }
 
 AActor* UTargetDetectionComponent::TryGetCameraCorrectionTarget()
@@ -504,7 +516,7 @@ void UTargetDetectionComponent::UpdateTargetSizeCategory(AActor* Target)
 		return;
 
 	EEnemySizeCategory NewCategory = AnalyzeTargetSize(Target);
-	EnemySizeCache.FindOrAdd(Target) = NewCategory;
+	EnemySizeCache.Add(Target, NewCategory);
 
 	if (bEnableSizeAnalysisDebugLogs)
 	{
@@ -516,26 +528,12 @@ void UTargetDetectionComponent::UpdateTargetSizeCategory(AActor* Target)
 
 void UTargetDetectionComponent::CleanupSizeCache()
 {
-	TArray<AActor*> InvalidActors;
+	// 缓存只持有弱引用，已销毁的Actor在垃圾回收后也会被自动清除
+	const int32 NumRemoved = EnemySizeCache.PurgeStale();
 
-	// ������Ч��Actor
-	for (auto& Pair : EnemySizeCache)
+	if (bEnableSizeAnalysisDebugLogs && NumRemoved > 0)
 	{
-		if (!IsValid(Pair.Key))
-		{
-			InvalidActors.Add(Pair.Key);
-		}
-	}
-
-	// �Ƴ���Ч�Ļ�����Ŀ
-	for (AActor* InvalidActor : InvalidActors)
-	{
-		EnemySizeCache.Remove(InvalidActor);
-	}
-
-	if (bEnableSizeAnalysisDebugLogs && InvalidActors.Num() > 0)
-	{
-		UE_LOG(LogTemp, Log, TEXT("TargetDetectionComponent: Cleaned up %d invalid size cache entries"), InvalidActors.Num());
+		UE_LOG(LogTemp, Log, TEXT("TargetDetectionComponent: Cleaned up %d invalid size cache entries"), NumRemoved);
 	}
 }
 
@@ -564,11 +562,12 @@ EEnemySizeCategory UTargetDetectionComponent::AnalyzeTargetSize(AActor* Target)
 	float BoundingBoxSize = CalculateTargetBoundingBoxSize(Target);
 
 	// ���ݸ߼���������е���ֵ���з���
-	if (BoundingBoxSize <= AdvancedCameraSettings.SmallEnemySizeThreshold)
+	const FAdvancedCameraSettings& Advanced = GetCompiledSettings().Advanced;
+	if (BoundingBoxSize <= Advanced.SmallEnemySizeThreshold)
 	{
 		return EEnemySizeCategory::Small;
 	}
-	else if (BoundingBoxSize <= AdvancedCameraSettings.LargeEnemySizeThreshold)
+	else if (BoundingBoxSize <= Advanced.LargeEnemySizeThreshold)
 	{
 		return EEnemySizeCategory::Medium;
 	}
@@ -593,13 +592,10 @@ bool UTargetDetectionComponent::IsTargetInSectorLockZone(AActor* Target) const
 
 	// ����Ƕ�
 	float DotProduct = FVector::DotProduct(CameraForward, ToTarget);
-	DotProduct = FMath::Clamp(DotProduct, -1.0f, 1.0f);
-	
-	float AngleRadians = FMath::Acos(DotProduct);
-	float AngleDegrees = FMath::RadiansToDegrees(AngleRadians);
 
 	// ����Ƿ�����������������
-	bool bInSectorZone = AngleDegrees <= (LockOnSettings.SectorLockAngle * 0.5f);
+	// 与编译后的半角余弦比较，无需反三角函数
+	bool bInSectorZone = DotProduct >= GetCompiledSettings().SectorHalfAngleCos;
 
 	return bInSectorZone;
 }
@@ -619,14 +615,12 @@ bool UTargetDetectionComponent::IsTargetInEdgeDetectionZone(AActor* Target) cons
 
 	// ����Ƕ�
 	float DotProduct = FVector::DotProduct(CameraForward, ToTarget);
-	DotProduct = FMath::Clamp(DotProduct, -1.0f, 1.0f);
-	
-	float AngleRadians = FMath::Acos(DotProduct);
-	float AngleDegrees = FMath::RadiansToDegrees(AngleRadians);
 
 	// ����Ƿ��ڱ�Ե���������
-	bool bInEdgeZone = (AngleDegrees > (LockOnSettings.SectorLockAngle * 0.5f)) && 
-					   (AngleDegrees <= (LockOnSettings.EdgeDetectionAngle * 0.5f));
+	// 与编译后的半角余弦比较，无需反三角函数
+	const FCompiledLockOnSettings& Compiled = GetCompiledSettings();
+	bool bInEdgeZone = (DotProduct < Compiled.SectorHalfAngleCos) && 
+					   (DotProduct >= Compiled.EdgeHalfAngleCos);
 
 	return bInEdgeZone;
 }
@@ -716,9 +710,26 @@ bool UTargetDetectionComponent::PerformLineOfSightCheck(AActor* Target) const
 	if (!OwnerCharacter || !Target)
 		return false;
 
+	// 渲染器已经知道结果时跳过射线
+	switch (PrefilterLineOfSight(Target))
+	{
+	case ELineOfSightPrefilter::Visible:
+		++LineOfSightStats.PrefilterAccepted;
+		return true;
+	case ELineOfSightPrefilter::Hidden:
+		++LineOfSightStats.PrefilterRejected;
+		return false;
+	default:
+		break;
+	}
+
+	++LineOfSightStats.Traces;
+	++TracesSinceLastConsume;
+
 	FHitResult HitResult;
-	FVector StartLocation = OwnerCharacter->GetActorLocation() + FVector(0, 0, LockOnSettings.RaycastHeightOffset);
-	FVector EndLocation = Target->GetActorLocation() + FVector(0, 0, LockOnSettings.RaycastHeightOffset);
+	const float RaycastHeightOffset = GetCompiledSettings().LockOn.RaycastHeightOffset;
+	FVector StartLocation = OwnerCharacter->GetActorLocation() + FVector(0, 0, RaycastHeightOffset);
+	FVector EndLocation = Target->GetActorLocation() + FVector(0, 0, RaycastHeightOffset);
 	
 	FCollisionQueryParams QueryParams;
 	QueryParams.AddIgnoredActor(OwnerCharacter);
@@ -744,35 +755,16 @@ float UTargetDetectionComponent::CalculateTargetScore(AActor* Target) const
 	if (!OwnerCharacter || !OwnerController || !Target)
 		return -1.0f;
 
-	FVector PlayerLocation = OwnerCharacter->GetActorLocation();
-	FVector ToTarget = (Target->GetActorLocation() - PlayerLocation).GetSafeNormal();
-	float Distance = FVector::Dist(PlayerLocation, Target->GetActorLocation());
-	
 	// ��ֹ�������
-	if (LockOnSettings.LockOnRange <= 0.0f)
+	if (GetCompiledSettings().LockOn.LockOnRange <= 0.0f)
 	{
 		UE_LOG(LogTemp, Error, TEXT("TargetDetectionComponent: LockOnRange is zero or negative!"));
 		return -1.0f;
 	}
-	
-	// ʹ�����ǰ������������
-	FVector CameraForward = OwnerController->GetControlRotation().Vector();
-	float DotProduct = FVector::DotProduct(CameraForward, ToTarget);
 
-	// �����㷨���Ƕ�����ռ70%����������ռ30%
-	float NormalizedDistance = FMath::Sqrt(Distance / LockOnSettings.LockOnRange);
-	float AngleFactor = DotProduct;
-	float DistanceFactor = 1.0f - NormalizedDistance;
-	
-	float Score = (AngleFactor * 0.7f) + (DistanceFactor * 0.3f);
-
-	// �ų���������ͬλ�õ�Ŀ��
-	if (Distance < 50.0f)
-	{
-		Score -= 0.5f; // �������֣����������������ص���Ŀ��
-	}
-
-	return Score;
+	// 与异步评分共用同一套公式
+	return FTargetScoringResult::ScoreTarget(GetCompiledSettings(), OwnerCharacter->GetActorLocation(),
+		OwnerController->GetControlRotation().Vector(), Target->GetActorLocation());
 }
 
 bool UTargetDetectionComponent::ValidateBasicTargetConditions(AActor* Target) const
@@ -784,6 +776,16 @@ bool UTargetDetectionComponent::ValidateBasicTargetConditions(AActor* Target) co
 		return false;
 	}
 
+	return IsLockableActor(Target);
+}
+
+bool UTargetDetectionComponent::IsLockableActor(const AActor* Target)
+{
+	if (!Target)
+	{
+		return false;
+	}
+
 	// ���ӵ���ʶ����
 	if (Target->ActorHasTag(FName("Friendly")) || Target->ActorHasTag(FName("Player")))
 	{
@@ -791,7 +793,7 @@ bool UTargetDetectionComponent::ValidateBasicTargetConditions(AActor* Target) co
 	}
 
 	// ���Ŀ���Ƿ񻹻��ţ����Ŀ��ΪPawn��	
-	if (APawn* TargetPawn = Cast<APawn>(Target))
+	if (const APawn* TargetPawn = Cast<APawn>(Target))
 	{
 		// ���Pawn�Ƿ����ٻ���Ч
 		if (!IsValid(TargetPawn) || TargetPawn->IsPendingKill())
@@ -801,4 +803,345 @@ bool UTargetDetectionComponent::ValidateBasicTargetConditions(AActor* Target) co
 	}
 
 	return true;
-}
\ No newline at end of file
+}
+
+// ==================== 异步评分 ====================
+
+void UTargetDetectionComponent::GatherScoringInput(FTargetScoringInput& OutInput)
+{
+	OutInput.Candidates.Reset();
+	OutInput.FrameNumber = GFrameCounter;
+
+	// 确保共享设置已构建，任务只持有不可变的共享实例
+	GetCompiledSettings();
+	OutInput.Settings = CompiledSettings;
+
+	ACharacter* OwnerCharacter = GetOwnerCharacter();
+	AController* OwnerController = GetOwnerController();
+	if (!OwnerCharacter || !OwnerController || !LockOnDetectionSphere)
+		return;
+
+	const FRotator ControlRotation = OwnerController->GetControlRotation();
+	OutInput.PlayerLocation = OwnerCharacter->GetActorLocation();
+	OutInput.CameraForward = ControlRotation.Vector();
+	OutInput.CameraRight = ControlRotation.RotateVector(FVector::RightVector);
+
+	// 多个本地玩家时使用共享候选：范围判断与包围盒已按目标计算一次，这里只剩视线检测
+	ULockOnCandidateSubsystem* Subsystem = SharedCandidates.Get();
+	if (bUseSharedCandidateQuery && Subsystem && Subsystem->GetNumLocalDetectors() > 1
+		&& ULockOnCandidateSubsystem::IsLocalDetector(this))
+	{
+		const float RangeSquared = GetCompiledSettings().LockOnRangeSquared;
+		for (const FSharedLockOnCandidate& Shared : Subsystem->GetCandidates())
+		{
+			AActor* Actor = Shared.Actor.Get();
+			if (!Actor || Actor == OwnerCharacter)
+				continue;
+
+			if (FVector::DistSquared(OutInput.PlayerLocation, Shared.Location) > RangeSquared)
+				continue;
+
+			if (!CheckLineOfSightScheduled(Actor, Shared.Location, OutInput))
+				continue;
+
+			FTargetScoringCandidate& Candidate = OutInput.Candidates.AddDefaulted_GetRef();
+			Candidate.Actor = Actor;
+			Candidate.Location = Shared.Location;
+			Candidate.BoundsSize = Shared.BoundsSize;
+		}
+		return;
+	}
+
+	TArray<AActor*> OverlappingActors;
+	LockOnDetectionSphere->GetOverlappingActors(OverlappingActors, APawn::StaticClass());
+
+	// 有效性与视线检测需要访问场景，留在游戏线程
+	const float RangeSquared = GetCompiledSettings().LockOnRangeSquared;
+	for (AActor* Actor : OverlappingActors)
+	{
+		if (!ValidateBasicTargetConditions(Actor))
+			continue;
+
+		const FVector Location = Actor->GetActorLocation();
+		if (FVector::DistSquared(OutInput.PlayerLocation, Location) > RangeSquared)
+			continue;
+
+		if (!CheckLineOfSightScheduled(Actor, Location, OutInput))
+			continue;
+
+		FTargetScoringCandidate& Candidate = OutInput.Candidates.AddDefaulted_GetRef();
+		Candidate.Actor = Actor;
+		Candidate.Location = Location;
+		Candidate.BoundsSize = EnemySizeCache.Contains(Actor) ? -1.0f : CalculateTargetBoundingBoxSize(Actor);
+	}
+}
+
+bool UTargetDetectionComponent::CheckLineOfSightScheduled(AActor* Target, const FVector& TargetLocation, const FTargetScoringInput& Input)
+{
+	if (!bEnableSignificanceLOD)
+	{
+		return PerformLineOfSightCheck(Target);
+	}
+
+	// 每次都按当前的视角重新评估重要度，转身后目标立即提升到更短的间隔
+	const bool bIsFocusOrNeighbour = Target == FocusTarget.Get() || Target == FocusNeighbours[0].Get() || Target == FocusNeighbours[1].Get();
+	const float Significance = FCandidateSignificance::Compute(*Input.Settings, Input.PlayerLocation, Input.CameraForward, TargetLocation, bIsFocusOrNeighbour);
+	const float RefreshInterval = FCandidateSignificance::GetRefreshInterval(Significance);
+
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+	if (const FCandidateLODState* State = CandidateLODCache.Find(Target))
+	{
+		if (CurrentTime - State->LastCheckTime < RefreshInterval)
+		{
+			++LineOfSightStats.ScheduleReused;
+			return State->bHasLineOfSight;
+		}
+	}
+
+	FCandidateLODState NewState;
+	NewState.LastCheckTime = CurrentTime;
+	NewState.bHasLineOfSight = PerformLineOfSightCheck(Target);
+	CandidateLODCache.Add(Target, NewState);
+	return NewState.bHasLineOfSight;
+}
+
+UTargetDetectionComponent::ELineOfSightPrefilter UTargetDetectionComponent::PrefilterLineOfSight(AActor* Target) const
+{
+	// 无渲染（专用服务器、-nullrhi回放）或非本地玩家时没有可用的渲染结果
+	if (!bUseRenderVisibilityPrefilter || !FApp::CanEverRender())
+		return ELineOfSightPrefilter::Ambiguous;
+
+	APlayerController* PlayerController = Cast<APlayerController>(GetOwnerController());
+	if (!PlayerController || !PlayerController->IsLocalController())
+		return ELineOfSightPrefilter::Ambiguous;
+
+	ULocalPlayer* LocalPlayer = PlayerController->GetLocalPlayer();
+	if (!LocalPlayer)
+		return ELineOfSightPrefilter::Ambiguous;
+
+	// 视锥：目标中心不在本玩家的视口内时，渲染结果来自其他视角或不存在
+	// GetViewportSize返回整个游戏视口，分屏时按本玩家的子视口比例缩放（投影坐标相对子视口）
+	int32 ViewportSizeX = 0;
+	int32 ViewportSizeY = 0;
+	PlayerController->GetViewportSize(ViewportSizeX, ViewportSizeY);
+	const float SubViewportSizeX = ViewportSizeX * LocalPlayer->Size.X;
+	const float SubViewportSizeY = ViewportSizeY * LocalPlayer->Size.Y;
+
+	FVector2D ScreenPosition;
+	if (SubViewportSizeX <= 0.0f || SubViewportSizeY <= 0.0f
+		|| !PlayerController->ProjectWorldLocationToScreen(Target->GetActorLocation(), ScreenPosition, true)
+		|| ScreenPosition.X < 0.0f || ScreenPosition.X > SubViewportSizeX
+		|| ScreenPosition.Y < 0.0f || ScreenPosition.Y > SubViewportSizeY)
+	{
+		PrefilterInViewportCache.Add(Target, false);
+		return ELineOfSightPrefilter::Ambiguous;
+	}
+
+	const bool* bWasInViewport = PrefilterInViewportCache.Find(Target);
+	const bool bJustEnteredViewport = !bWasInViewport || !*bWasInViewport;
+	PrefilterInViewportCache.Add(Target, true);
+
+	// 只看屏幕渲染时间：阴影深度等Pass也会刷新LastRenderTime，墙后敌人的阴影在屏幕上时不能据此认定可见
+	const UWorld* World = GetWorld();
+	const bool bRenderedOnScreen = World && World->GetTimeSeconds() - GetLastRenderTimeOnScreen(Target) <= RENDER_VISIBILITY_TOLERANCE;
+
+	// 在视锥内：未被渲染说明对本玩家已被遮挡剔除；刚进入视口（快速转向）的目标可能还没来得及渲染，交给射线检测
+	if (!bRenderedOnScreen)
+		return bJustEnteredViewport ? ELineOfSightPrefilter::Ambiguous : ELineOfSightPrefilter::Hidden;
+
+	// 分屏时渲染结果可能来自其他玩家的视角，不能据此认定本玩家可见
+	if (GEngine && GEngine->GetNumGamePlayers(GetWorld()) > 1)
+		return ELineOfSightPrefilter::Ambiguous;
+
+	return ELineOfSightPrefilter::Visible;
+}
+
+float UTargetDetectionComponent::GetLastRenderTimeOnScreen(const AActor* Target)
+{
+	float LastRenderTime = -1000.0f;
+	Target->ForEachComponent<UPrimitiveComponent>(false, [&LastRenderTime](const UPrimitiveComponent* Primitive)
+	{
+		if (Primitive->IsRegistered())
+		{
+			LastRenderTime = FMath::Max(LastRenderTime, Primitive->GetLastRenderTimeOnScreen());
+		}
+	});
+	return LastRenderTime;
+}
+
+void UTargetDetectionComponent::SetFocusTarget(AActor* Target)
+{
+	if (FocusTarget.Get() == Target)
+		return;
+
+	FocusTarget = Target;
+	UpdateSwitchNeighbours();
+}
+
+void UTargetDetectionComponent::UpdateSwitchNeighbours()
+{
+	FocusNeighbours[0].Reset();
+	FocusNeighbours[1].Reset();
+
+	AActor* Focus = FocusTarget.Get();
+	if (!Focus)
+		return;
+
+	const TArray<FScoredTarget>& Targets = FrontScoringResult->Targets;
+
+	// 锁定目标的方向角：优先取结果中的值，保证与其他候选来自同一视角
+	float FocusAngle = 0.0f;
+	const int32 FocusIndex = Targets.IndexOfByPredicate([Focus](const FScoredTarget& Scored) { return Scored.Actor.Get() == Focus; });
+	if (FocusIndex != INDEX_NONE)
+	{
+		FocusAngle = Targets[FocusIndex].DirectionAngle;
+	}
+	else
+	{
+		FocusAngle = CalculateDirectionAngle(Focus);
+	}
+
+	// 左侧取方向角小于锁定目标的最大者，右侧取大于锁定目标的最小者；并列时取更近的
+	int32 BestIndex[2] = { INDEX_NONE, INDEX_NONE };
+	for (int32 Index = 0; Index < Targets.Num(); ++Index)
+	{
+		const FScoredTarget& Scored = Targets[Index];
+		if (Index == FocusIndex || !Scored.Actor.IsValid())
+			continue;
+
+		const float Delta = Scored.DirectionAngle - FocusAngle;
+		const int32 Side = Delta < 0.0f ? 0 : 1;
+		const float AngleGap = FMath::Abs(Delta);
+
+		if (BestIndex[Side] == INDEX_NONE)
+		{
+			BestIndex[Side] = Index;
+			continue;
+		}
+
+		const FScoredTarget& Best = Targets[BestIndex[Side]];
+		const float BestGap = FMath::Abs(Best.DirectionAngle - FocusAngle);
+		if (AngleGap < BestGap - SWITCH_TIE_ANGLE
+			|| (AngleGap <= BestGap + SWITCH_TIE_ANGLE && Scored.DistanceSquared < Best.DistanceSquared))
+		{
+			BestIndex[Side] = Index;
+		}
+	}
+
+	for (int32 Side = 0; Side < 2; ++Side)
+	{
+		if (BestIndex[Side] != INDEX_NONE)
+		{
+			FocusNeighbours[Side] = Targets[BestIndex[Side]].Actor;
+		}
+	}
+}
+
+void UTargetDetectionComponent::DispatchTargetScoring()
+{
+	// 上一次的结果尚未发布时不派发新任务
+	if (ScoringTask.IsValid())
+		return;
+
+	GatherScoringInput(*ScoringInput);
+
+	// 任务只持有共享的输入与后台缓冲，组件销毁后也不会访问悬空内存
+	TSharedPtr<const FTargetScoringInput> Input = ScoringInput;
+	TSharedPtr<FTargetScoringResult> Output = BackScoringResult;
+	ScoringTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Input, Output]()
+	{
+		Output->Build(*Input);
+	});
+}
+
+void UTargetDetectionComponent::ConsumeTargetScoring()
+{
+	if (!ScoringTask.IsValid() || !ScoringTask.IsCompleted())
+		return;
+
+	ScoringTask = UE::Tasks::FTask();
+
+	// 派发之后同步路径已发布过更新的结果时丢弃
+	if (BackScoringResult->FrameNumber < FrontScoringResult->FrameNumber)
+		return;
+
+	Swap(FrontScoringResult, BackScoringResult);
+	PublishScoringResult();
+}
+
+void UTargetDetectionComponent::WaitForTargetScoring()
+{
+	if (ScoringTask.IsValid())
+	{
+		ScoringTask.Wait();
+		ScoringTask = UE::Tasks::FTask();
+	}
+}
+
+void UTargetDetectionComponent::PublishScoringResult()
+{
+	LockOnCandidates.Reset();
+
+	// 快照之后可能已被销毁的目标在此过滤
+	for (const FScoredTarget& Scored : FrontScoringResult->Targets)
+	{
+		AActor* Actor = Scored.Actor.Get();
+		if (!IsValid(Actor))
+			continue;
+
+		LockOnCandidates.Add(Actor);
+
+		if (Scored.SizeCategory != EEnemySizeCategory::Unknown && !EnemySizeCache.Contains(Actor))
+		{
+			EnemySizeCache.Add(Actor, Scored.SizeCategory);
+		}
+	}
+
+	// 切换目标随每次发布增量更新，切换输入只需直接读取
+	UpdateSwitchNeighbours();
+
+	if (OnTargetsUpdated.IsBound())
+	{
+		OnTargetsUpdated.Broadcast(LockOnCandidates);
+	}
+}
+
+AActor* UTargetDetectionComponent::GetScoredActor(int32 Index) const
+{
+	if (!FrontScoringResult->Targets.IsValidIndex(Index))
+		return nullptr;
+
+	AActor* Actor = FrontScoringResult->Targets[Index].Actor.Get();
+	return IsValid(Actor) ? Actor : nullptr;
+}
+
+// ==================== 控制台命令 ====================
+
+static FAutoConsoleCommand CmdSoulLockOnTraceStats(
+	TEXT("Soul.LockOn.TraceStats"),
+	TEXT("Print how many lock-on line-of-sight traces were avoided by the render visibility prefilter and significance scheduling: Soul.LockOn.TraceStats [reset]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const bool bReset = Args.Num() > 0 && Args[0].Equals(TEXT("reset"), ESearchCase::IgnoreCase);
+
+		for (TObjectIterator<UTargetDetectionComponent> It; It; ++It)
+		{
+			UTargetDetectionComponent* Component = *It;
+			UWorld* World = Component->GetWorld();
+			if (!World || !World->IsGameWorld() || Component->IsTemplate())
+				continue;
+
+			const UTargetDetectionComponent::FLineOfSightStats& Stats = Component->GetLineOfSightStats();
+			const int32 Total = Stats.GetAvoided() + Stats.Traces;
+			UE_LOG(LogSoul, Warning, TEXT("%s: Traces=%d Avoided=%d (%.1f%%) [PrefilterVisible=%d PrefilterHidden=%d ScheduleReused=%d]"),
+				*GetNameSafe(Component->GetOwner()), Stats.Traces, Stats.GetAvoided(),
+				Total > 0 ? 100.0f * Stats.GetAvoided() / Total : 0.0f,
+				Stats.PrefilterAccepted, Stats.PrefilterRejected, Stats.ScheduleReused);
+
+			if (bReset)
+			{
+				Component->ResetLineOfSightStats();
+			}
+		}
+	})
+);
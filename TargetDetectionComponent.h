@@ -5,6 +5,9 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "LockOnConfig.h"
+#include "TargetScoring.h"
+#include "ActorKeyedCache.h"
+#include "Tasks/Task.h"
 #include "TargetDetectionComponent.generated.h"
 
 // ǰ������
@@ -30,6 +33,8 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
 
 public:
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
@@ -45,17 +50,9 @@ public:
 
 	// ==================== ���ò��� ====================
 	/** ����ϵͳ���� */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lock-On Settings")
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Lock-On Settings")
 	FLockOnSettings LockOnSettings;
 
-	/** ���ϵͳ���� */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera Settings")
-	FCameraSettings CameraSettings;
-
-	/** �߼�������� */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Advanced Camera Settings")
-	FAdvancedCameraSettings AdvancedCameraSettings;
-
 	/** SocketͶ������ */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Socket Projection Settings")
 	FSocketProjectionSettings SocketProjectionSettings;
@@ -74,6 +71,43 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug")
 	bool bEnableSizeAnalysisDebugLogs;
 
+	/** 周期搜索时在工作线程评分排序，结果下一帧发布（锁定输入仍走同步路径） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Target Detection")
+	bool bAsyncTargetScoring = true;
+
+	/** 多个本地玩家（分屏）时使用世界共享的候选收集，而不是各自的球体重叠 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Target Detection")
+	bool bUseSharedCandidateQuery = true;
+
+	/** 按候选的重要度调度视线检测：近处视野内的目标每次搜索都检测，远处或身后的目标最多每秒一次 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Target Detection")
+	bool bEnableSignificanceLOD = true;
+
+	/** 视线检测前先用渲染可见性预筛：视口内且最近被渲染的目标直接通过，视口内未被渲染（被遮挡剔除）的直接拒绝 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Target Detection")
+	bool bUseRenderVisibilityPrefilter = true;
+
+	/** 视线检测统计（累计） */
+	struct FLineOfSightStats
+	{
+		/** 预筛判定可见、跳过射线 */
+		int32 PrefilterAccepted = 0;
+
+		/** 预筛判定被遮挡、跳过射线 */
+		int32 PrefilterRejected = 0;
+
+		/** 重要度调度复用上次结果、跳过射线 */
+		int32 ScheduleReused = 0;
+
+		/** 实际执行的射线检测 */
+		int32 Traces = 0;
+
+		int32 GetAvoided() const { return PrefilterAccepted + PrefilterRejected + ScheduleReused; }
+	};
+
+	const FLineOfSightStats& GetLineOfSightStats() const { return LineOfSightStats; }
+	void ResetLineOfSightStats() { LineOfSightStats = FLineOfSightStats(); }
+
 protected:
 	// ==================== �ڲ�״̬���� ====================
 	/** ��ǰ������Ŀ���б� */
@@ -81,8 +115,10 @@ protected:
 	TArray<AActor*> LockOnCandidates;
 
 	/** ���˳ߴ���໺�� */
-	UPROPERTY()
-	TMap<AActor*, EEnemySizeCategory> EnemySizeCache;
+	TActorKeyedCache<EEnemySizeCategory> EnemySizeCache{ TEXT("TargetDetection.EnemySize"), SIZE_CACHE_CAPACITY };
+
+	/** 编译后的共享锁定设置（热路径只读取它） */
+	mutable TSharedPtr<const FCompiledLockOnSettings> CompiledSettings;
 
 	/** �ϴ�Ŀ������ʱ�� */
 	float LastTargetSearchTime;
@@ -96,6 +132,9 @@ protected:
 	/** �����Ż����ߴ���¼�� */
 	static constexpr float SIZE_UPDATE_INTERVAL = 1.0f;
 
+	/** 尺寸缓存容量（超出时淘汰最久未使用的敌人） */
+	static constexpr int32 SIZE_CACHE_CAPACITY = 128;
+
 public:
 	// ==================== ��Ҫ�ӿں��� ====================
 	
@@ -107,6 +146,32 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Target Detection")
 	const TArray<AActor*>& GetLockOnCandidates() const { return LockOnCandidates; }
 
+	/** 修改锁定设置（运行时只能通过它修改，拥有者随后重建编译后的共享设置） */
+	UFUNCTION(BlueprintCallable, Category = "Target Detection")
+	void SetLockOnSettings(const FLockOnSettings& Settings);
+
+	/** 锁定设置变更时触发（拥有者据此重建编译后的共享设置） */
+	FSimpleMulticastDelegate OnLockOnSettingsChanged;
+
+	/** 设置共享的编译后锁定设置（由拥有者统一构建并分发） */
+	void SetCompiledSettings(TSharedPtr<const FCompiledLockOnSettings> InCompiledSettings);
+
+	/** 获取编译后的锁定设置（尚未分发时根据本组件的配置构建一次） */
+	const FCompiledLockOnSettings& GetCompiledSettings() const;
+
+	/** 周期搜索是否使用异步评分 */
+	bool IsAsyncTargetScoringEnabled() const { return bAsyncTargetScoring; }
+
+	/** 最近发布的评分结果（与GetLockOnCandidates对应） */
+	const FTargetScoringResult& GetScoringResult() const { return *FrontScoringResult; }
+
+	/** 取出并清零上次汇总以来的视线检测数（共享候选子系统每帧汇总到追踪计数器） */
+	int32 ConsumeTraceCount() { const int32 Count = TracesSinceLastConsume; TracesSinceLastConsume = 0; return Count; }
+
+	/** 从最近发布的结果中取扇区优先、其次边缘区域的最佳目标（不刷新候选） */
+	UFUNCTION(BlueprintCallable, Category = "Target Detection")
+	AActor* GetCachedBestSectorLockTarget() const;
+
 	/** ��ȡĿ��ĳߴ���� */
 	UFUNCTION(BlueprintCallable, Category = "Target Detection")
 	EEnemySizeCategory GetTargetSizeCategory(AActor* Target);
@@ -125,6 +190,20 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Target Detection")
 	bool IsTargetStillLockable(AActor* Target);
 
+	/** 与玩家无关的可锁定判断（友方/玩家标签、已销毁），共享候选收集也使用 */
+	static bool IsLockableActor(const AActor* Target);
+
+	/** 当前锁定的目标：变化时重新计算左右切换目标，它与左右相邻的候选始终按最高重要度刷新 */
+	void SetFocusTarget(AActor* Target);
+
+	/** 预先计算的左侧切换目标（无则返回nullptr） */
+	UFUNCTION(BlueprintCallable, Category = "Target Detection")
+	AActor* GetLeftSwitchTarget() const { return FocusNeighbours[0].Get(); }
+
+	/** 预先计算的右侧切换目标（无则返回nullptr） */
+	UFUNCTION(BlueprintCallable, Category = "Target Detection")
+	AActor* GetRightSwitchTarget() const { return FocusNeighbours[1].Get(); }
+
 	/** ��Ŀ���б��л�ȡ���Ŀ�� */
 	UFUNCTION(BlueprintCallable, Category = "Target Detection")
 	AActor* GetBestTargetFromList(const TArray<AActor*>& TargetList);
@@ -212,4 +291,89 @@ private:
 
 	/** �ڲ���������֤Ŀ��Ļ������� */
 	bool ValidateBasicTargetConditions(AActor* Target) const;
+
+	// ==================== 异步评分 ====================
+
+	/** 在游戏线程采集候选（含视线检测）与相机基向量的快照 */
+	void GatherScoringInput(FTargetScoringInput& OutInput);
+
+	/** 派发评分任务，结果写入后台缓冲 */
+	void DispatchTargetScoring();
+
+	/** 评分任务完成后交换缓冲并发布 */
+	void ConsumeTargetScoring();
+
+	/** 等待进行中的评分任务（同步路径使用后台缓冲前调用） */
+	void WaitForTargetScoring();
+
+	/** 把前台缓冲发布为候选列表，并补充尺寸缓存 */
+	void PublishScoringResult();
+
+	/** 前台结果中指定索引的目标（已失效时返回nullptr） */
+	AActor* GetScoredActor(int32 Index) const;
+
+	/** 双缓冲：前台只在游戏线程读取，后台由评分任务写入 */
+	TSharedPtr<FTargetScoringResult> FrontScoringResult;
+	TSharedPtr<FTargetScoringResult> BackScoringResult;
+
+	/** 复用的评分输入 */
+	TSharedPtr<FTargetScoringInput> ScoringInput;
+
+	/** 进行中的评分任务 */
+	UE::Tasks::FTask ScoringTask;
+
+	// ==================== 渲染可见性预筛 ====================
+
+	enum class ELineOfSightPrefilter : uint8
+	{
+		Visible,
+		Hidden,
+		Ambiguous
+	};
+
+	/** 用本地玩家视口与渲染时间判断目标可见性，无法判断时返回Ambiguous（需要射线检测） */
+	ELineOfSightPrefilter PrefilterLineOfSight(AActor* Target) const;
+
+	/** 目标任一图元最近一次在屏幕上（主视图，不含阴影等其他Pass）被渲染的时间 */
+	static float GetLastRenderTimeOnScreen(const AActor* Target);
+
+	/** 判定最近被渲染的时间容差（秒） */
+	static constexpr float RENDER_VISIBILITY_TOLERANCE = 0.1f;
+
+	/** 上次预筛时目标是否在本玩家视口内（刚进入视口的目标尚未被渲染，不能据此判定为被遮挡） */
+	mutable TActorKeyedCache<bool> PrefilterInViewportCache{ TEXT("TargetDetection.PrefilterInViewport"), SIZE_CACHE_CAPACITY };
+
+	mutable FLineOfSightStats LineOfSightStats;
+
+	/** 自上次被共享候选子系统汇总以来发出的视线检测数（SoulLockOn追踪计数器） */
+	mutable int32 TracesSinceLastConsume = 0;
+
+	// ==================== 重要度调度 ====================
+
+	/** 候选的视线检测调度状态 */
+	struct FCandidateLODState
+	{
+		double LastCheckTime = 0.0;
+		bool bHasLineOfSight = false;
+	};
+
+	/** 按重要度决定复用上次的视线结果还是重新检测 */
+	bool CheckLineOfSightScheduled(AActor* Target, const FVector& TargetLocation, const FTargetScoringInput& Input);
+
+	/**
+	 * 在最近发布的结果中找出锁定目标左右最近的候选（发布结果或锁定目标变化时调用）
+	 * 方向角相差不到SWITCH_TIE_ANGLE的候选视为并列，取距离更近的
+	 */
+	void UpdateSwitchNeighbours();
+
+	static constexpr float SWITCH_TIE_ANGLE = 2.0f;
+
+	TActorKeyedCache<FCandidateLODState> CandidateLODCache{ TEXT("TargetDetection.CandidateLOD"), SIZE_CACHE_CAPACITY };
+
+	TWeakObjectPtr<AActor> FocusTarget;
+	/** 左/右切换目标 */
+	TWeakObjectPtr<AActor> FocusNeighbours[2];
+
+	/** 注册到的共享候选子系统 */
+	TWeakObjectPtr<class ULockOnCandidateSubsystem> SharedCandidates;
 };
\ No newline at end of file
@@ -0,0 +1,145 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "TargetScoring.h"
+
+void FTargetScoringResult::Build(const FTargetScoringInput& Input)
+{
+	Reset();
+	FrameNumber = Input.FrameNumber;
+	bValid = true;
+
+	if (!Input.Settings.IsValid())
+		return;
+
+	const FCompiledLockOnSettings& Settings = *Input.Settings;
+
+	Targets.Reserve(Input.Candidates.Num());
+	for (const FTargetScoringCandidate& Candidate : Input.Candidates)
+	{
+		FScoredTarget& Scored = Targets.AddDefaulted_GetRef();
+		Scored.Actor = Candidate.Actor;
+		Scored.Score = ScoreTarget(Settings, Input.PlayerLocation, Input.CameraForward, Candidate.Location);
+
+		const FVector ToTarget = (Candidate.Location - Input.PlayerLocation).GetSafeNormal();
+		const float ForwardDot = FVector::DotProduct(Input.CameraForward, ToTarget);
+		const float RightDot = FVector::DotProduct(Input.CameraRight, ToTarget);
+		Scored.DirectionAngle = FMath::RadiansToDegrees(FMath::Atan2(RightDot, ForwardDot));
+		Scored.DistanceSquared = FVector::DistSquared(Input.PlayerLocation, Candidate.Location);
+
+		if (ForwardDot >= Settings.SectorHalfAngleCos)
+		{
+			Scored.Zone = ETargetScoringZone::Sector;
+		}
+		else if (ForwardDot >= Settings.EdgeHalfAngleCos)
+		{
+			Scored.Zone = ETargetScoringZone::Edge;
+		}
+
+		if (Candidate.BoundsSize >= 0.0f)
+		{
+			Scored.SizeCategory = ClassifySize(Settings, Candidate.BoundsSize);
+		}
+	}
+
+	// 从左到右排序
+	Targets.Sort([](const FScoredTarget& A, const FScoredTarget& B)
+	{
+		return A.DirectionAngle < B.DirectionAngle;
+	});
+
+	float BestScore = -1.0f;
+	float BestSectorScore = -1.0f;
+	float BestEdgeScore = -1.0f;
+	for (int32 Index = 0; Index < Targets.Num(); ++Index)
+	{
+		const FScoredTarget& Scored = Targets[Index];
+		if (Scored.Score > BestScore)
+		{
+			BestScore = Scored.Score;
+			BestIndex = Index;
+		}
+
+		if (Scored.Zone == ETargetScoringZone::Sector && Scored.Score > BestSectorScore)
+		{
+			BestSectorScore = Scored.Score;
+			BestSectorIndex = Index;
+		}
+		else if (Scored.Zone == ETargetScoringZone::Edge && Scored.Score > BestEdgeScore)
+		{
+			BestEdgeScore = Scored.Score;
+			BestEdgeIndex = Index;
+		}
+	}
+}
+
+void FTargetScoringResult::Reset()
+{
+	Targets.Reset();
+	BestIndex = INDEX_NONE;
+	BestSectorIndex = INDEX_NONE;
+	BestEdgeIndex = INDEX_NONE;
+	FrameNumber = 0;
+	bValid = false;
+}
+
+float FTargetScoringResult::ScoreTarget(const FCompiledLockOnSettings& Settings, const FVector& PlayerLocation, const FVector& CameraForward, const FVector& TargetLocation)
+{
+	if (Settings.LockOn.LockOnRange <= 0.0f)
+		return -1.0f;
+
+	const FVector ToTarget = (TargetLocation - PlayerLocation).GetSafeNormal();
+	const float Distance = FVector::Dist(PlayerLocation, TargetLocation);
+
+	// 角度占70%，距离占30%
+	const float AngleFactor = FVector::DotProduct(CameraForward, ToTarget);
+	const float DistanceFactor = Settings.GetDistanceScore(Distance);
+	float Score = (AngleFactor * 0.7f) + (DistanceFactor * 0.3f);
+
+	// 与玩家几乎重叠的目标降分
+	if (Distance < 50.0f)
+	{
+		Score -= 0.5f;
+	}
+
+	return Score;
+}
+
+EEnemySizeCategory FTargetScoringResult::ClassifySize(const FCompiledLockOnSettings& Settings, float BoundsSize)
+{
+	if (BoundsSize <= Settings.Advanced.SmallEnemySizeThreshold)
+	{
+		return EEnemySizeCategory::Small;
+	}
+	if (BoundsSize <= Settings.Advanced.LargeEnemySizeThreshold)
+	{
+		return EEnemySizeCategory::Medium;
+	}
+	return EEnemySizeCategory::Large;
+}
+
+float FCandidateSignificance::Compute(const FCompiledLockOnSettings& Settings, const FVector& ViewLocation, const FVector& ViewForward, const FVector& TargetLocation, bool bIsFocusOrNeighbour)
+{
+	if (bIsFocusOrNeighbour)
+		return 1.0f;
+
+	const FVector ToTarget = TargetLocation - ViewLocation;
+	const float DistanceFactor = 1.0f - FMath::Clamp(ToTarget.Size() * Settings.InvLockOnRange, 0.0f, 1.0f);
+
+	// 正前方为1，正后方为0
+	const float AngleFactor = (FVector::DotProduct(ViewForward, ToTarget.GetSafeNormal()) + 1.0f) * 0.5f;
+
+	return DistanceFactor * 0.5f + AngleFactor * 0.5f;
+}
+
+float FCandidateSignificance::GetRefreshInterval(float Significance)
+{
+	if (Significance >= HIGH_SIGNIFICANCE)
+	{
+		return 0.0f;
+	}
+	if (Significance >= MEDIUM_SIGNIFICANCE)
+	{
+		return MEDIUM_REFRESH_INTERVAL;
+	}
+	return LOW_REFRESH_INTERVAL;
+}
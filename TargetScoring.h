@@ -0,0 +1,113 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LockOnConfig.h"
+
+class AActor;
+
+/** 候选目标相对相机的区域 */
+enum class ETargetScoringZone : uint8
+{
+	None,
+	Sector,
+	Edge
+};
+
+/** 游戏线程采集的单个候选快照 */
+struct SOUL_API FTargetScoringCandidate
+{
+	TWeakObjectPtr<AActor> Actor;
+	FVector Location = FVector::ZeroVector;
+
+	/** 边界盒最大尺寸（小于0表示已有尺寸缓存，无需分类） */
+	float BoundsSize = -1.0f;
+};
+
+/**
+ * 目标评分输入
+ * 只包含数值与弱引用，工作线程上不会解引用任何UObject。
+ */
+struct SOUL_API FTargetScoringInput
+{
+	TSharedPtr<const FCompiledLockOnSettings> Settings;
+
+	FVector PlayerLocation = FVector::ZeroVector;
+	FVector CameraForward = FVector::ForwardVector;
+	FVector CameraRight = FVector::RightVector;
+
+	TArray<FTargetScoringCandidate> Candidates;
+
+	/** 采集快照时的帧号 */
+	uint64 FrameNumber = 0;
+};
+
+/** 单个候选的评分结果 */
+struct SOUL_API FScoredTarget
+{
+	TWeakObjectPtr<AActor> Actor;
+	float Score = -1.0f;
+
+	/** 相对相机前方的水平方向角（-180到180，左负右正） */
+	float DirectionAngle = 0.0f;
+
+	/** 到玩家的距离平方 */
+	float DistanceSquared = 0.0f;
+
+	ETargetScoringZone Zone = ETargetScoringZone::None;
+
+	/** 本次分类得到的尺寸（未分类时为Unknown） */
+	EEnemySizeCategory SizeCategory = EEnemySizeCategory::Unknown;
+};
+
+/**
+ * 候选重要度
+ * 按距离、相对相机的角度以及是否为当前/相邻目标打分，映射为视线检测等昂贵检查的刷新间隔：
+ * 近处且在视野内的目标每次搜索都刷新，远处或身后的目标每秒刷新一次。
+ */
+struct SOUL_API FCandidateSignificance
+{
+	/** 重要度（0到1，距离与角度各占一半）；当前锁定目标及其左右相邻目标固定为1 */
+	static float Compute(const FCompiledLockOnSettings& Settings, const FVector& ViewLocation, const FVector& ViewForward, const FVector& TargetLocation, bool bIsFocusOrNeighbour);
+
+	/** 重要度对应的刷新间隔（秒，0表示每次搜索都刷新） */
+	static float GetRefreshInterval(float Significance);
+
+	static constexpr float HIGH_SIGNIFICANCE = 0.6f;
+	static constexpr float MEDIUM_SIGNIFICANCE = 0.35f;
+	static constexpr float MEDIUM_REFRESH_INTERVAL = 0.5f;
+	static constexpr float LOW_REFRESH_INTERVAL = 1.0f;
+};
+
+/**
+ * 目标评分结果
+ * 候选按方向角从左到右排序，并记录全体/扇区/边缘区域内得分最高的索引。
+ * Build是纯计算，可以在游戏线程同步调用，也可以作为UE::Tasks任务在工作线程执行。
+ */
+struct SOUL_API FTargetScoringResult
+{
+public:
+	/** 根据快照计算评分、区域、尺寸并排序 */
+	void Build(const FTargetScoringInput& Input);
+
+	void Reset();
+
+	/** 单个目标的评分（角度占70%，距离占30%，与玩家几乎重叠的目标降分） */
+	static float ScoreTarget(const FCompiledLockOnSettings& Settings, const FVector& PlayerLocation, const FVector& CameraForward, const FVector& TargetLocation);
+
+	/** 按尺寸阈值分类 */
+	static EEnemySizeCategory ClassifySize(const FCompiledLockOnSettings& Settings, float BoundsSize);
+
+	TArray<FScoredTarget> Targets;
+
+	int32 BestIndex = INDEX_NONE;
+	int32 BestSectorIndex = INDEX_NONE;
+	int32 BestEdgeIndex = INDEX_NONE;
+
+	/** 来源快照的帧号 */
+	uint64 FrameNumber = 0;
+
+	/** 是否已有有效结果 */
+	bool bValid = false;
+};
@@ -0,0 +1,182 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "TerrainHeightCache.h"
+#include "GameFramework/Actor.h"
+#include "Engine/World.h"
+
+FTerrainHeightCache::FTerrainHeightCache()
+	: CenterCell(FIntPoint::ZeroValue)
+	, ReferenceZ(0.0f)
+	, TracesThisFrame(0)
+{
+	Samples.SetNum(GRID_SIZE * GRID_SIZE);
+}
+
+void FTerrainHeightCache::Initialize(AActor* InOwner)
+{
+	Owner = InOwner;
+	Reset();
+}
+
+void FTerrainHeightCache::Reset()
+{
+	for (FHeightSample& Sample : Samples)
+	{
+		Sample = FHeightSample();
+	}
+	PendingSamples.Reset();
+	TracesThisFrame = 0;
+}
+
+void FTerrainHeightCache::Tick(const FVector& CenterLocation)
+{
+	TracesThisFrame = 0;
+	ReferenceZ = CenterLocation.Z;
+
+	// 平移网格中心：环形索引下旧槽位通过Cell比对自动失效
+	CenterCell = FIntPoint(
+		FMath::FloorToInt(CenterLocation.X / CELL_SIZE),
+		FMath::FloorToInt(CenterLocation.Y / CELL_SIZE));
+
+	AActor* OwnerActor = Owner.Get();
+	UWorld* World = OwnerActor ? OwnerActor->GetWorld() : nullptr;
+	if (!World)
+	{
+		PendingSamples.Reset();
+		return;
+	}
+
+	// 拉取上一帧发起的采样结果
+	for (int32 Index = PendingSamples.Num() - 1; Index >= 0; --Index)
+	{
+		const FPendingSample& Pending = PendingSamples[Index];
+		FHeightSample& Sample = Samples[GetSlotIndex(Pending.Cell)];
+
+		FTraceDatum TraceDatum;
+		if (World->QueryTraceData(Pending.Handle, TraceDatum))
+		{
+			// 槽位已被平移复用时丢弃结果
+			if (Sample.Cell == Pending.Cell && Sample.State == ESampleState::Pending)
+			{
+				const FHitResult* Hit = FHitResult::GetFirstBlockingHit(TraceDatum.OutHits);
+				if (Hit)
+				{
+					Sample.Height = Hit->ImpactPoint.Z;
+					Sample.State = ESampleState::Valid;
+				}
+				else
+				{
+					// 没有地面，下次查询时重新采样
+					Sample.State = ESampleState::Empty;
+				}
+			}
+			PendingSamples.RemoveAtSwap(Index);
+		}
+		else if (!World->IsTraceHandleValid(Pending.Handle, false))
+		{
+			if (Sample.Cell == Pending.Cell)
+			{
+				Sample.State = ESampleState::Empty;
+			}
+			PendingSamples.RemoveAtSwap(Index);
+		}
+	}
+}
+
+bool FTerrainHeightCache::GetGroundHeight(const FVector& Location, float& OutHeight)
+{
+	if (!IsInsideGrid(Location))
+		return false;
+
+	float GridX = Location.X / CELL_SIZE;
+	float GridY = Location.Y / CELL_SIZE;
+	FIntPoint BaseCell(FMath::FloorToInt(GridX), FMath::FloorToInt(GridY));
+	float Alpha = GridX - BaseCell.X;
+	float Beta = GridY - BaseCell.Y;
+
+	// 四个顶点都需要查询（以便一次性排队缺失的采样）
+	float H00 = 0.0f, H10 = 0.0f, H01 = 0.0f, H11 = 0.0f;
+	bool bHas00 = GetVertexHeight(BaseCell, H00);
+	bool bHas10 = GetVertexHeight(BaseCell + FIntPoint(1, 0), H10);
+	bool bHas01 = GetVertexHeight(BaseCell + FIntPoint(0, 1), H01);
+	bool bHas11 = GetVertexHeight(BaseCell + FIntPoint(1, 1), H11);
+
+	if (!bHas00 || !bHas10 || !bHas01 || !bHas11)
+		return false;
+
+	OutHeight = FMath::BiLerp(H00, H10, H01, H11, Alpha, Beta);
+	return true;
+}
+
+bool FTerrainHeightCache::IsInsideGrid(const FVector& Location) const
+{
+	// 需要右上方的相邻顶点，所以有效范围比网格少一个单元
+	const int32 HalfSize = GRID_SIZE / 2;
+	int32 CellX = FMath::FloorToInt(Location.X / CELL_SIZE);
+	int32 CellY = FMath::FloorToInt(Location.Y / CELL_SIZE);
+	return CellX >= CenterCell.X - HalfSize && CellX < CenterCell.X + HalfSize - 1
+		&& CellY >= CenterCell.Y - HalfSize && CellY < CenterCell.Y + HalfSize - 1;
+}
+
+int32 FTerrainHeightCache::GetSlotIndex(const FIntPoint& Cell) const
+{
+	int32 SlotX = ((Cell.X % GRID_SIZE) + GRID_SIZE) % GRID_SIZE;
+	int32 SlotY = ((Cell.Y % GRID_SIZE) + GRID_SIZE) % GRID_SIZE;
+	return SlotY * GRID_SIZE + SlotX;
+}
+
+bool FTerrainHeightCache::GetVertexHeight(const FIntPoint& Cell, float& OutHeight)
+{
+	FHeightSample& Sample = Samples[GetSlotIndex(Cell)];
+	if (Sample.Cell == Cell)
+	{
+		if (Sample.State == ESampleState::Valid)
+		{
+			OutHeight = Sample.Height;
+			return true;
+		}
+		if (Sample.State == ESampleState::Pending)
+		{
+			return false;
+		}
+	}
+
+	RequestSample(Cell);
+	return false;
+}
+
+void FTerrainHeightCache::RequestSample(const FIntPoint& Cell)
+{
+	if (TracesThisFrame >= MAX_TRACES_PER_FRAME)
+		return;
+
+	AActor* OwnerActor = Owner.Get();
+	UWorld* World = OwnerActor ? OwnerActor->GetWorld() : nullptr;
+	if (!World)
+		return;
+
+	FVector VertexLocation(Cell.X * CELL_SIZE, Cell.Y * CELL_SIZE, ReferenceZ);
+	FVector TraceStart = VertexLocation + FVector(0.0f, 0.0f, TRACE_HALF_HEIGHT);
+	FVector TraceEnd = VertexLocation - FVector(0.0f, 0.0f, TRACE_HALF_HEIGHT);
+
+	FCollisionQueryParams QueryParams;
+	QueryParams.AddIgnoredActor(OwnerActor);
+
+	// 只检测静态几何体，避免敌人或其他角色被当作地面
+	FPendingSample Pending;
+	Pending.Cell = Cell;
+	Pending.Handle = World->AsyncLineTraceByObjectType(
+		EAsyncTraceType::Single,
+		TraceStart,
+		TraceEnd,
+		FCollisionObjectQueryParams(ECC_WorldStatic),
+		QueryParams
+	);
+	PendingSamples.Add(Pending);
+
+	FHeightSample& Sample = Samples[GetSlotIndex(Cell)];
+	Sample.Cell = Cell;
+	Sample.State = ESampleState::Pending;
+
+	++TracesThisFrame;
+}
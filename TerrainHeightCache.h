@@ -0,0 +1,95 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorldCollision.h"
+
+class AActor;
+
+/**
+ * 以玩家为中心的滚动地形高度缓存
+ * 网格顶点的地面高度通过异步射线按需采样，玩家移动时网格随之平移（环形索引，无需拷贝）
+ * 地形查询变为双线性插值查表，锁定期间每帧查询几乎没有射线开销
+ */
+struct SOUL_API FTerrainHeightCache
+{
+public:
+	/** 网格边长（顶点数） */
+	static constexpr int32 GRID_SIZE = 32;
+
+	/** 网格单元尺寸 */
+	static constexpr float CELL_SIZE = 128.0f;
+
+	/** 采样射线相对玩家高度的上下范围 */
+	static constexpr float TRACE_HALF_HEIGHT = 2000.0f;
+
+	/** 每帧最多发起的异步采样数 */
+	static constexpr int32 MAX_TRACES_PER_FRAME = 8;
+
+	FTerrainHeightCache();
+
+	/** 绑定拥有者（采样时忽略该Actor，并从其获取World） */
+	void Initialize(AActor* InOwner);
+
+	/** 清空所有采样 */
+	void Reset();
+
+	/** 拉取异步采样结果并把网格中心平移到玩家所在单元（每帧调用） */
+	void Tick(const FVector& CenterLocation);
+
+	/**
+	 * 双线性插值查询地面高度
+	 * 所需顶点尚未采样时会排队异步采样并返回false，调用方应使用回退逻辑
+	 */
+	bool GetGroundHeight(const FVector& Location, float& OutHeight);
+
+	/** 位置是否处于当前网格覆盖范围内 */
+	bool IsInsideGrid(const FVector& Location) const;
+
+private:
+	enum class ESampleState : uint8
+	{
+		Empty,
+		Pending,
+		Valid
+	};
+
+	struct FHeightSample
+	{
+		/** 该槽位当前对应的世界网格坐标（用于识别平移后失效的槽位） */
+		FIntPoint Cell = FIntPoint(MAX_int32, MAX_int32);
+		float Height = 0.0f;
+		ESampleState State = ESampleState::Empty;
+	};
+
+	struct FPendingSample
+	{
+		FTraceHandle Handle;
+		FIntPoint Cell;
+	};
+
+	/** 世界网格坐标映射到环形槽位 */
+	int32 GetSlotIndex(const FIntPoint& Cell) const;
+
+	/** 获取指定顶点的有效高度，缺失时排队采样 */
+	bool GetVertexHeight(const FIntPoint& Cell, float& OutHeight);
+
+	/** 发起一个顶点的异步采样 */
+	void RequestSample(const FIntPoint& Cell);
+
+	TWeakObjectPtr<AActor> Owner;
+
+	TArray<FHeightSample> Samples;
+
+	TArray<FPendingSample> PendingSamples;
+
+	/** 网格中心所在的世界网格坐标 */
+	FIntPoint CenterCell;
+
+	/** 采样射线的参考高度（玩家高度） */
+	float ReferenceZ;
+
+	/** 本帧已发起的采样数 */
+	int32 TracesThisFrame;
+};
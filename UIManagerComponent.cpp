@@ -5,10 +5,14 @@
 #include "Blueprint/UserWidget.h"
 #include "Components/WidgetComponent.h"
 #include "Components/SkeletalMeshComponent.h"
+#include "SocketResolutionCache.h"
 #include "Engine/Engine.h"
 #include "UObject/UObjectGlobals.h"
 #include "UObject/StructOnScope.h"
 #include "UObject/UObjectIterator.h"
+#include "DebugManager.h"
+#include "SoulTrace.h"
+#include "CameraControlComponent.h"
 
 // Sets default values for this component's properties
 UUIManagerComponent::UUIManagerComponent()
@@ -33,7 +37,6 @@ UUIManagerComponent::UUIManagerComponent()
 
 	// Initialize socket projection settings with defaults from LockOnConfig
 	HybridProjectionSettings = FHybridProjectionSettings();
-	AdvancedCameraSettings = FAdvancedCameraSettings();
 
 	// Initialize arrays
 	TargetsWithActiveWidgets.Empty();
@@ -54,6 +57,15 @@ void UUIManagerComponent::BeginPlay()
 	InitializeUIManager();
 }
 
+// Report cache memory to memreport (obj list)
+void UUIManagerComponent::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(
+		WidgetComponentCache.GetAllocatedSize() + EnemySizeCache.GetAllocatedSize() + TargetsWithActiveWidgets.GetAllocatedSize());
+}
+
 // Called every frame
 void UUIManagerComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
@@ -62,6 +74,8 @@ void UUIManagerComponent::TickComponent(float DeltaTime, ELevelTick TickType, FA
 	// Update owner references if needed
 	UpdateOwnerReferences();
 
+	SOUL_TRACE_COUNTER_SET(SoulLockOn_ActiveWidgets, TargetsWithActiveWidgets.Num());
+
 	// === 步骤1修复：添加更新频率限制 ===
 	if (CurrentUIDisplayMode == EUIDisplayMode::SocketProjection && CurrentLockOnTarget)
 	{
@@ -98,12 +112,8 @@ void UUIManagerComponent::ShowLockOnWidget(AActor* Target)
 		// ��Ƶ��־�Ż� - ���ӽ�Ƶ����
 		if (bEnableUIDebugLogs)
 		{
-			static int32 FrameCounter = 0;
-			if (++FrameCounter % 300 == 0) // ÿ5��ֻ��¼һ��
-			{
-				UE_LOG(LogTemp, Warning, TEXT("UIManagerComponent::ShowLockOnWidget - Invalid target: %s"), 
-					Target ? *Target->GetName() : TEXT("None"));
-			}
+			SOUL_LOG_WARNING_RATE_LIMITED(UI, 5.0, TEXT("UIManagerComponent::ShowLockOnWidget - Invalid target: %s"), 
+				Target ? *Target->GetName() : TEXT("None"));
 		}
 		return;
 	}
@@ -124,15 +134,11 @@ void UUIManagerComponent::ShowLockOnWidget(AActor* Target)
 		case EUIDisplayMode::Traditional3D:
 			// Traditional 3D space UI display
 			{
-				UActorComponent* WidgetComp = Target->GetComponentByClass(UWidgetComponent::StaticClass());
-				if (WidgetComp)
+				UWidgetComponent* WidgetComponent = FindTargetWidgetComponent(Target);
+				if (WidgetComponent)
 				{
-					UWidgetComponent* WidgetComponent = Cast<UWidgetComponent>(WidgetComp);
-					if (WidgetComponent)
-					{
-						WidgetComponent->SetVisibility(true);
-						TargetsWithActiveWidgets.AddUnique(Target);
-					}
+					WidgetComponent->SetVisibility(true);
+					TargetsWithActiveWidgets.AddUnique(Target);
 				}
 			}
 			break;
@@ -263,18 +269,14 @@ void UUIManagerComponent::HideLockOnWidget()
 void UUIManagerComponent::HideAllLockOnWidgets()
 {
 	// Hide all traditional 3D widgets
-	for (AActor* Target : TargetsWithActiveWidgets)
+	for (const TWeakObjectPtr<AActor>& Target : TargetsWithActiveWidgets)
 	{
-		if (IsValid(Target))
+		if (Target.IsValid())
 		{
-			UActorComponent* WidgetComp = Target->GetComponentByClass(UWidgetComponent::StaticClass());
-			if (WidgetComp)
+			UWidgetComponent* WidgetComponent = FindTargetWidgetComponent(Target.Get());
+			if (WidgetComponent && WidgetComponent->IsVisible())
 			{
-				UWidgetComponent* WidgetComponent = Cast<UWidgetComponent>(WidgetComp);
-				if (WidgetComponent && WidgetComponent->IsVisible())
-				{
-					WidgetComponent->SetVisibility(false);
-				}
+				WidgetComponent->SetVisibility(false);
 			}
 		}
 	}
@@ -339,14 +341,10 @@ void UUIManagerComponent::UpdateLockOnWidget(AActor* CurrentTarget, AActor* Prev
 		else
 		{
 			// Hide traditional 3D widget of previous target
-			UActorComponent* PrevWidgetComp = PreviousTarget->GetComponentByClass(UWidgetComponent::StaticClass());
-			if (PrevWidgetComp)
+			UWidgetComponent* PrevWidgetComponent = FindTargetWidgetComponent(PreviousTarget);
+			if (PrevWidgetComponent && PrevWidgetComponent->IsVisible())
 			{
-				UWidgetComponent* PrevWidgetComponent = Cast<UWidgetComponent>(PrevWidgetComp);
-				if (PrevWidgetComponent && PrevWidgetComponent->IsVisible())
-				{
-					PrevWidgetComponent->SetVisibility(false);
-				}
+				PrevWidgetComponent->SetVisibility(false);
 			}
 		}
 	}
@@ -475,10 +473,10 @@ bool UUIManagerComponent::HasValidSocket(AActor* Target) const
 	USkeletalMeshComponent* SkeletalMesh = Target->FindComponentByClass<USkeletalMeshComponent>();
 	if (SkeletalMesh)
 	{
-		// Use a common socket name for checking
-		FName SocketName = TEXT("Spine2Socket");
-		bool bSocketExists = SkeletalMesh->DoesSocketExist(SocketName);
-		return bSocketExists;
+		// Use a common socket name for checking (resolved once per mesh asset)
+		static const FName SocketName(TEXT("Spine2Socket"));
+		const FResolvedSocket* Resolved = FSocketResolutionCache::Resolve(SkeletalMesh, SocketName);
+		return Resolved && Resolved->IsValid();
 	}
 
 	return false;
@@ -668,6 +666,8 @@ void UUIManagerComponent::UpdateProjectionWidget(AActor* Target)
 	if (!Target || !LockOnWidgetInstance || !LockOnWidgetInstance->IsInViewport())
 		return;
 
+	SOUL_PERFORMANCE_SCOPE(TEXT("UIManager::UpdateProjectionWidget"));
+
 	// Get target projection location using hybrid projection system
 	FVector ProjectionLocation = GetTargetProjectionLocation(Target);
 	
@@ -822,9 +822,34 @@ void UUIManagerComponent::SetHybridProjectionSettings(const FHybridProjectionSet
 	}
 }
 
+const FAdvancedCameraSettings& UUIManagerComponent::GetAdvancedCameraSettings() const
+{
+	if (CompiledSettings.IsValid())
+	{
+		return CompiledSettings->Advanced;
+	}
+
+	const UCameraControlComponent* CameraControl = GetOwner() ? GetOwner()->FindComponentByClass<UCameraControlComponent>() : nullptr;
+	if (CameraControl)
+	{
+		return CameraControl->AdvancedCameraSettings;
+	}
+
+	static const FAdvancedCameraSettings DefaultSettings;
+	return DefaultSettings;
+}
+
 void UUIManagerComponent::SetAdvancedCameraSettings(const FAdvancedCameraSettings& NewSettings)
 {
-	AdvancedCameraSettings = NewSettings;
+	// The UI keeps no copy of its own: the camera control component's rebuilding setter is the only write path
+	UCameraControlComponent* CameraControl = GetOwner() ? GetOwner()->FindComponentByClass<UCameraControlComponent>() : nullptr;
+	if (!CameraControl)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UIManagerComponent::SetAdvancedCameraSettings - Owner has no CameraControlComponent, settings ignored"));
+		return;
+	}
+
+	CameraControl->SetAdvancedCameraSettings(NewSettings);
 	
 	if (bEnableUIDebugLogs)
 	{
@@ -1104,6 +1129,24 @@ void UUIManagerComponent::ClearWidgetComponentCache()
 	}
 }
 
+UWidgetComponent* UUIManagerComponent::FindTargetWidgetComponent(AActor* Target)
+{
+	if (!IsValid(Target))
+		return nullptr;
+	
+	if (TWeakObjectPtr<UWidgetComponent>* Cached = WidgetComponentCache.Find(Target))
+	{
+		if (Cached->IsValid())
+		{
+			return Cached->Get();
+		}
+	}
+	
+	UWidgetComponent* WidgetComponent = Target->FindComponentByClass<UWidgetComponent>();
+	WidgetComponentCache.Add(Target, WidgetComponent);
+	return WidgetComponent;
+}
+
 void UUIManagerComponent::UpdateOwnerReferences()
 {
 	// Update owner character if not set
@@ -1230,25 +1273,12 @@ void UUIManagerComponent::UpdateTargetSizeCategory(AActor* Target)
 
 void UUIManagerComponent::CleanupSizeCache()
 {
-	// Remove invalid entries from size cache
-	TArray<AActor*> InvalidTargets;
-	
-	for (const TPair<AActor*, EEnemySizeCategory>& Pair : EnemySizeCache)
-	{
-		if (!IsValid(Pair.Key))
-		{
-			InvalidTargets.Add(Pair.Key);
-		}
-	}
-	
-	for (AActor* InvalidTarget : InvalidTargets)
-	{
-		EnemySizeCache.Remove(InvalidTarget);
-	}
+	// Entries only hold weak keys; destroyed targets are also purged after every garbage collection
+	const int32 NumRemoved = EnemySizeCache.PurgeStale() + WidgetComponentCache.PurgeStale();
 	
-	if (bEnableUIDebugLogs && InvalidTargets.Num() > 0)
+	if (bEnableUIDebugLogs && NumRemoved > 0)
 	{
 		UE_LOG(LogTemp, Log, TEXT("UIManagerComponent::CleanupSizeCache - Removed %d invalid entries"), 
-			InvalidTargets.Num());
+			NumRemoved);
 	}
 }
\ No newline at end of file
@@ -9,6 +9,7 @@
 #include "Components/WidgetComponent.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "LockOnConfig.h"
+#include "ActorKeyedCache.h"
 #include "UIManagerComponent.generated.h"
 
 // Forward declarations
@@ -148,6 +149,11 @@ public:
 	 */
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
+	/**
+	 * Report cache memory to memreport (obj list)
+	 */
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+
 	// ==================== Core Public Interface ====================
 
 	/**
@@ -321,12 +327,20 @@ public:
 
 	/**
 	 * Get advanced camera settings
+	 * Reads the shared compiled settings, or the owner's camera control component before they are distributed
 	 */
 	UFUNCTION(BlueprintPure, Category = "UI Manager")
-	const FAdvancedCameraSettings& GetAdvancedCameraSettings() const { return AdvancedCameraSettings; }
+	const FAdvancedCameraSettings& GetAdvancedCameraSettings() const;
+
+	/**
+	 * Set the shared compiled lock-on settings (built and distributed by the owner)
+	 * @param InCompiledSettings - Shared immutable settings
+	 */
+	void SetCompiledSettings(TSharedPtr<const FCompiledLockOnSettings> InCompiledSettings) { CompiledSettings = InCompiledSettings; }
 
 	/**
 	 * Set advanced camera settings
+	 * Forwards to the owner's camera control component setter, which rebuilds and redistributes the shared compiled settings
 	 * @param NewSettings - The new advanced camera settings
 	 */
 	UFUNCTION(BlueprintCallable, Category = "UI Manager")
@@ -375,9 +389,8 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UI Configuration")
 	FHybridProjectionSettings HybridProjectionSettings;
 
-	/** Advanced camera settings for size adaptation */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UI Configuration")
-	FAdvancedCameraSettings AdvancedCameraSettings;
+	/** Shared compiled settings distributed by the owner */
+	TSharedPtr<const FCompiledLockOnSettings> CompiledSettings;
 
 	/** Multi-part configuration */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UI Configuration")
@@ -437,17 +450,18 @@ protected:
 	UPROPERTY()
 	AActor* CurrentLockOnTarget;
 
-	/** List of targets with active widgets */
-	UPROPERTY()
-	TArray<AActor*> TargetsWithActiveWidgets;
+	/** List of targets with active widgets (weak, destroyed targets are skipped) */
+	TArray<TWeakObjectPtr<AActor>> TargetsWithActiveWidgets;
 
-	/** Cache of widget components found on targets */
-	UPROPERTY()
-	TMap<AActor*, UWidgetComponent*> WidgetComponentCache;
+	/** Cache of widget components found on targets (bounded, least recently used entries are evicted) */
+	TActorKeyedCache<TWeakObjectPtr<UWidgetComponent>> WidgetComponentCache{ TEXT("UIManager.WidgetComponent"), WIDGET_CACHE_CAPACITY };
 
-	/** Cache of enemy size categories for performance optimization */
-	UPROPERTY()
-	TMap<AActor*, EEnemySizeCategory> EnemySizeCache;
+	/** Cache of enemy size categories for performance optimization (bounded, least recently used entries are evicted) */
+	TActorKeyedCache<EEnemySizeCategory> EnemySizeCache{ TEXT("UIManager.EnemySize"), SIZE_CACHE_CAPACITY };
+
+	/** Cache capacities */
+	static constexpr int32 WIDGET_CACHE_CAPACITY = 32;
+	static constexpr int32 SIZE_CACHE_CAPACITY = 64;
 
 	/** Current UI scale being applied */
 	float CurrentUIScale = 1.0f;
@@ -492,6 +506,13 @@ protected:
 	 */
 	void ClearWidgetComponentCache();
 
+	/**
+	 * Find the widget component on a target (cached per target)
+	 * @param Target - The target actor
+	 * @return Widget component, or nullptr if the target has none
+	 */
+	UWidgetComponent* FindTargetWidgetComponent(AActor* Target);
+
 	/**
 	 * Update owner references (Character and Controller)
 	 */
@@ -0,0 +1,137 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "VerticalProbeCache.h"
+#include "GameFramework/Actor.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+
+FVerticalProbeCache::FVerticalProbeCache()
+	: PendingPawnSearchDistance(0.0f)
+	, GroundDistance(0.0f)
+	, bHasResult(false)
+{
+}
+
+void FVerticalProbeCache::Initialize(AActor* InOwner)
+{
+	Owner = InOwner;
+	Reset();
+}
+
+void FVerticalProbeCache::Reset()
+{
+	PendingHandle = FTraceHandle();
+	GroundDistance = 0.0f;
+	PawnsBelow.Reset();
+	bHasResult = false;
+}
+
+void FVerticalProbeCache::Tick(bool bAirborne, float PawnSearchDistance)
+{
+	AActor* OwnerActor = Owner.Get();
+	UWorld* World = OwnerActor ? OwnerActor->GetWorld() : nullptr;
+	if (!World)
+	{
+		Reset();
+		return;
+	}
+
+	// 在地面时完全空闲（丢弃进行中的探测结果）
+	if (!bAirborne)
+	{
+		if (bHasResult || PendingHandle.IsValid())
+		{
+			Reset();
+		}
+		return;
+	}
+
+	// 拉取上一帧发起的探测结果
+	if (PendingHandle.IsValid())
+	{
+		FTraceDatum TraceDatum;
+		if (World->QueryTraceData(PendingHandle, TraceDatum))
+		{
+			ApplyTraceResult(TraceDatum);
+			PendingHandle = FTraceHandle();
+		}
+		else if (!World->IsTraceHandleValid(PendingHandle, false))
+		{
+			PendingHandle = FTraceHandle();
+		}
+	}
+
+	// 每帧最多一次探测
+	if (PendingHandle.IsValid())
+		return;
+
+	const FVector TraceStart = OwnerActor->GetActorLocation();
+	const FVector TraceEnd = TraceStart - FVector(0.0f, 0.0f, PROBE_DISTANCE);
+
+	FCollisionQueryParams QueryParams;
+	QueryParams.AddIgnoredActor(OwnerActor);
+	QueryParams.bTraceComplex = false;
+
+	FCollisionObjectQueryParams ObjectParams;
+	ObjectParams.AddObjectTypesToQuery(ECC_WorldStatic);
+	ObjectParams.AddObjectTypesToQuery(ECC_Pawn);
+
+	PendingPawnSearchDistance = PawnSearchDistance;
+	PendingHandle = World->AsyncLineTraceByObjectType(
+		EAsyncTraceType::Multi,
+		TraceStart,
+		TraceEnd,
+		ObjectParams,
+		QueryParams
+	);
+}
+
+void FVerticalProbeCache::GetPawnsBelow(TArray<AActor*>& OutPawns) const
+{
+	OutPawns.Reset(PawnsBelow.Num());
+	for (const TWeakObjectPtr<AActor>& Pawn : PawnsBelow)
+	{
+		if (AActor* PawnActor = Pawn.Get())
+		{
+			OutPawns.Add(PawnActor);
+		}
+	}
+}
+
+void FVerticalProbeCache::ApplyTraceResult(const FTraceDatum& TraceDatum)
+{
+	GroundDistance = 0.0f;
+	PawnsBelow.Reset();
+	bHasResult = true;
+
+	// 第一个静态几何体即地面
+	float GroundHitDistance = TNumericLimits<float>::Max();
+	for (const FHitResult& Hit : TraceDatum.OutHits)
+	{
+		const UPrimitiveComponent* HitComponent = Hit.GetComponent();
+		if (HitComponent && HitComponent->GetCollisionObjectType() == ECC_WorldStatic)
+		{
+			GroundHitDistance = FMath::Min(GroundHitDistance, FVector::Dist(TraceDatum.Start, Hit.Location));
+		}
+	}
+
+	if (GroundHitDistance < TNumericLimits<float>::Max())
+	{
+		GroundDistance = GroundHitDistance;
+	}
+
+	// 地面以上、搜索距离以内的角色
+	const float PawnLimit = FMath::Min(PendingPawnSearchDistance, GroundHitDistance);
+	for (const FHitResult& Hit : TraceDatum.OutHits)
+	{
+		const UPrimitiveComponent* HitComponent = Hit.GetComponent();
+		AActor* HitActor = Hit.GetActor();
+		if (!HitActor || !HitComponent || HitComponent->GetCollisionObjectType() != ECC_Pawn)
+			continue;
+
+		if (FVector::Dist(TraceDatum.Start, Hit.Location) <= PawnLimit)
+		{
+			PawnsBelow.AddUnique(HitActor);
+		}
+	}
+}
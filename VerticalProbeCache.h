@@ -0,0 +1,59 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorldCollision.h"
+
+class AActor;
+
+/**
+ * 角色的竖直探测缓存
+ * 仅在空中时每帧发起一次向下的异步多重射线（静态几何体与Pawn），缓存离地距离和正下方的角色；
+ * 落地后不再发起任何射线。坠落攻击与处决高度相关的查询全部读取缓存。
+ */
+struct SOUL_API FVerticalProbeCache
+{
+public:
+	/** 向下探测的最大距离 */
+	static constexpr float PROBE_DISTANCE = 10000.0f;
+
+	FVerticalProbeCache();
+
+	/** 绑定拥有者（探测时忽略该Actor，并从其获取World） */
+	void Initialize(AActor* InOwner);
+
+	/** 清空缓存与未完成的探测 */
+	void Reset();
+
+	/**
+	 * 拉取上一帧的探测结果，空中时发起下一次探测（每帧调用）
+	 * @param bAirborne 拥有者当前是否在空中
+	 * @param PawnSearchDistance 收集下方角色的距离
+	 */
+	void Tick(bool bAirborne, float PawnSearchDistance);
+
+	/** 是否已有本次腾空的探测结果（起跳后第一个结果返回前为false） */
+	bool HasResult() const { return bHasResult; }
+
+	/** 离地距离（在地面或没有结果时为0） */
+	float GetGroundDistance() const { return GroundDistance; }
+
+	/** 下方的角色（按距离由近到远，不含地面以下的角色） */
+	void GetPawnsBelow(TArray<AActor*>& OutPawns) const;
+
+private:
+	/** 处理一次探测结果 */
+	void ApplyTraceResult(const FTraceDatum& TraceDatum);
+
+	TWeakObjectPtr<AActor> Owner;
+
+	/** 进行中的探测 */
+	FTraceHandle PendingHandle;
+	float PendingPawnSearchDistance;
+
+	float GroundDistance;
+	TArray<TWeakObjectPtr<AActor>> PawnsBelow;
+
+	bool bHasResult;
+};